@@ -10,20 +10,29 @@
 #define PARSYBONE_DATA_TYPES_INCLUDED
 
 #include <algorithm>
+#include <atomic>
+#include <cerrno>
 #include <climits>
 #include <cmath>
 #include <chrono>
+#include <condition_variable>
 #include <cstring>
+#include <deque>
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <numeric>
 #include <queue>
 #include <regex>
 #include <set>
+#include <sstream>
 #include <string>
 #include <stdexcept>
+#include <thread>
 
 #include <boost/assert.hpp>
 #include <boost/lexical_cast.hpp>
@@ -32,6 +41,7 @@
 #include <boost/range/algorithm.hpp>
 #include <boost/range/counting_range.hpp>
 #include <boost/range/irange.hpp>
+#include <boost/range/iterator_range.hpp>
 
 #include <gecode/int.hh>
 #include <gecode/search.hh>
@@ -120,6 +130,12 @@ typedef unsigned long long ParamNo;
 /// Index of the color - may be a big number as well.
 typedef unsigned long long RoundNo;
 
+/// Set of parametrizations from a single block - i-th bit stands for the i-th parametrization of the block.
+typedef unsigned long long ParamMask;
+
+/// Maximal number of parametrizations that can be checked at once within a single block.
+const size_t MASK_WIDTH = sizeof(ParamMask) * CHAR_BIT;
+
 /// IDs of predecessors of a state.
 typedef vector<StateID> Neighbours;
 
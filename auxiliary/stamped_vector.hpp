@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2012-2013 - Adam Streck
+ * This file is a part of the ParSyBoNe (Parameter Synthetizer for Boolean Networks) verification tool.
+ * ParSyBoNe is a free software: you can redistribute it and/or modify it under the terms of the GNU General Public License version 3.
+ * ParSyBoNe is released without any warranty. See the GNU General Public License for more details. <http://www.gnu.org/licenses/>.
+ * For affiliations see <http://www.mi.fu-berlin.de/en/math/groups/dibimath> and <http://sybila.fi.muni.cz/>.
+ */
+
+#ifndef PARSYBONE_STAMPED_VECTOR_INCLUDED
+#define PARSYBONE_STAMPED_VECTOR_INCLUDED
+
+#include "data_types.hpp"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief A vector of a fixed size that can be reset to the default value in constant time.
+///
+/// Each value carries a stamp of the epoch in which it was written. Reset only starts a new epoch, the values with an older stamp are then considered
+/// to hold the default value. The stamps are cleared for real only once the epoch counter overflows.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename ValueT>
+class StampedVector {
+	vector<ValueT> values;
+	vector<unsigned int> stamps; ///< Epoch in which the value has been written.
+	unsigned int epoch; ///< Current epoch, starts from 1 so that 0 is never current.
+	ValueT default_value;
+
+public:
+	StampedVector(const size_t size = 0, const ValueT & _default_value = ValueT()) : values(size), stamps(size, 0), epoch(1), default_value(_default_value) {}
+
+	/**
+	 * Change the size, all the values are reset.
+	 */
+	void resize(const size_t size) {
+		values.resize(size);
+		stamps.assign(size, 0);
+		epoch = 1;
+	}
+
+	/**
+	 * Set all the values to the default one.
+	 */
+	inline void reset() {
+		if (++epoch == 0) {
+			stamps.assign(stamps.size(), 0);
+			epoch = 1;
+		}
+	}
+
+	inline size_t size() const {
+		return stamps.size();
+	}
+
+	/**
+	 * @return true if the value has been written since the last reset
+	 */
+	inline bool isSet(const size_t index) const {
+		return stamps[index] == epoch;
+	}
+
+	/**
+	 * Make the value current, set it to the default if it has not been written since the last reset.
+	 * @return true if the value has not been written since the last reset
+	 */
+	inline bool touch(const size_t index) {
+		if (stamps[index] == epoch)
+			return false;
+		stamps[index] = epoch;
+		values[index] = default_value;
+		return true;
+	}
+
+	inline const ValueT & get(const size_t index) const {
+		return stamps[index] == epoch ? values[index] : default_value;
+	}
+
+	inline ValueT & operator[](const size_t index) {
+		touch(index);
+		return values[index];
+	}
+
+	friend void swap(StampedVector & first, StampedVector & second) {
+		swap(first.values, second.values);
+		swap(first.stamps, second.stamps);
+		swap(first.epoch, second.epoch);
+		swap(first.default_value, second.default_value);
+	}
+};
+
+#endif // PARSYBONE_STAMPED_VECTOR_INCLUDED
@@ -48,7 +48,7 @@ const Version getVersion() {
 
 const string getUsage() {
    return
-         "parsybone model.pmf property.ppf [database1.sqlite,...] [-cdfmrvwW] [--bound N] [--data database_file] [--file text_file] [--dist I N] [--help] [--ver]\n"
+         "parsybone model.pmf property.ppf [database1.sqlite,...] [-cdfmrvwW] [--bound N] [--block N] [--intervals N] [--symbolic] [--incremental] [--gray] [--memoize] [--backward] [--threads N] [--bfs-threads N] [--data database_file] [--file text_file] [--dist I N] [--help] [--ver]\n"
          "\n"
          "model.pmf            name of the file that will be parsed and used, must have a .pmf suffix; model is used as the name of the model (and thus impicit output) further in the program\n"
          "property.ppf         name of the property file that will be parset and used with the model, must have a .ppf suffix\n"
@@ -59,7 +59,7 @@ const string getUsage() {
          "   by default the file is model.sqlite, can be changed using the --data switch\n"
          "-f output computation results to a text file\n"
          "   by default the file is model.out, can be changed using the --file switch\n"
-         "-m minimize the Cost - only parametrizations whose paths have globaly minimal cost will be output\n"
+         "-m minimize the Cost - only parametrizations whose paths have globaly minimal cost will be output, all at the end of the computation\n"
          "-n negate the property - only the parametrizations that do not satisfy the property will be output\n"
          "-r compute robustness of a time series\n"
          "-v verbose (output progress to console)\n"
@@ -67,7 +67,25 @@ const string getUsage() {
          "-W compute witnesses and store them in explicit form\n"
          "\n"
          "--bound constraints the depth of a depth-first search to the value N\n"
+         "--block check N consecutive parametrizations at once within a single coloring, N is at most 64\n"
+         "--intervals check windows of N consecutive parametrizations at once, carried through the coloring as intervals, implies --block 64 if no block is given\n"
+         "        pays off for large windows, each window starts at the first round not yet checked, can not be used together with --threads or --dist\n"
+         "--symbolic check all the parametrizations at once with the sets of parametrizations held in a decision diagram, for spaces too large to enumerate\n"
+         "        the parametrizations are enumerated only if an output is requested, can be used only with -m, -n, --bound and the outputs\n"
+         "--incremental resume the BFS of each parametrization from that of the previous one, up to the first level whose spreading the change affects\n"
+         "        pays off for large products whose parametrizations differ in the transitions used late in the BFS, not used for the levels split by --bfs-threads\n"
+         "--gray check the parametrizations in the Gray code order, so that the successive ones differ in a single subcolor of a single specie\n"
+         "        the parametrizations keep their numbers, with --dist each process checks a contiguous part of the order, can not be used together with --block, --intervals or --threads auto\n"
+         "--memoize reuse the Cost of a parametrization for those that agree on the targets of all the contexts its check has read\n"
+         "        pays off if the checks read only a part of the contexts, not used for the analysis (-r, -w, -W)\n"
+         "--backward for a time series property, find the states from which the final ones can be reached within the bound before the BFS of a parametrization\n"
+         "        the BFS then enters only those, pays off if most of the reachable states lead nowhere, not used for blocks, --intervals or --bfs-threads\n"
+         "--threads check the parametrizations by N threads that share the product, the output is the same as for a single thread\n"
+         "          with N = auto, the parametrizations are first sampled to choose the number of threads, whether they share the BFS and the block size\n"
+         "--bfs-threads split each BFS level of a single parametrization between N threads, for products too large to check many parametrizations at once\n"
+         "        block checks are not split, can not be used together with --threads or --dist 0 N\n"
          "--dist  used for distributed computation with two integers, denoting the I-th process out of N. Total - each of those tests only 1/N of the parametrization space.\n"
+         "        with I = 0 the process forks N local worker processes, hands out the parametrizations to them and outputs all the results itself (POSIX only)\n"
          "--help  display help\n"
          "--ver   display the current version\n"
          ;
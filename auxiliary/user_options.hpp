@@ -31,6 +31,17 @@ struct UserOptions {
    size_t bound_size;
    size_t process_number; ///< What is the ID of this process?
    size_t processes_count; ///< How many processes are included in the computation?
+   size_t block_size; ///< How many parametrizations are checked at once by a single coloring?
+   size_t interval_size; ///< How many parametrizations are checked at once by an interval check, 0 if the intervals are not used?
+   size_t threads_count; ///< How many threads conduct the synthesis within this process?
+   size_t bfs_threads_count; ///< How many threads share the BFS of a single parametrization?
+   bool use_symbolic; ///< Should all the parametrizations be checked at once within a decision diagram?
+   bool use_incremental; ///< Should each check be resumed from the BFS of the previous parametrization?
+   bool use_gray; ///< Should the parametrizations be checked in the Gray code order?
+   bool use_memoization; ///< Should the Cost be reused for the parametrizations that agree on the contexts consulted by an earlier check?
+   bool use_backward; ///< Should the BFS of a time series be limited to the states from which a final state can be reached?
+   bool plan_parallel; ///< Should the threads and the block size be chosen by a calibration?
+   size_t workers_count; ///< How many local worker processes are forked by this process, 0 if this process computes by itself.
    string model_path;
    string property_path;
    string model_name; ///< What is the name of the model?
@@ -55,10 +66,11 @@ struct UserOptions {
     * Constructor, sets up default values.
     */
    UserOptions() {
-      compute_wintess = minimalize_cost = be_verbose = use_long_witnesses = compute_robustness = output_console = use_textfile = use_database = produce_negative = false;
+      compute_wintess = minimalize_cost = be_verbose = use_long_witnesses = compute_robustness = output_console = use_textfile = use_database = produce_negative = plan_parallel = use_symbolic = use_incremental = use_gray = use_memoization = use_backward = false;
       database_file = datatext_file = "";
       bound_size = INF;
-      process_number = processes_count = 1;
+      process_number = processes_count = block_size = threads_count = bfs_threads_count = 1;
+      workers_count = interval_size = 0;
       model_path = model_name = "";
    }
 
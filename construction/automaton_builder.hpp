@@ -26,35 +26,6 @@ class AutomatonBuilder {
 	const PropertyAutomaton & property;
 
 	vector<string> names; ///< Name of the i-th specie.
-	Levels maxes; ///< Maximal activity levels of the species.
-	Levels mins; ///< Minimal activity levels of the species.
-	Levels range_size; ///< Number of valid values for the species.
-
-	/**
-	 * Compute a vector of maximal levels and store information about states.
-	 */
-	void computeBoundaries() {
-		// Compute naive bounds.
-		for (const SpecieID ID : cscope(model.species)) {
-			// Maximal values of species
-			names.push_back(model.species[ID].name);
-			maxes.push_back(model.species[ID].max_value);
-			mins.push_back(0);
-		}
-
-		// Add experiment constraints.
-		ConstraintParser * cons_pars = new ConstraintParser(model.species.size(), ModelTranslators::getMaxLevel(model));
-		cons_pars->addBoundaries(maxes, true);
-		cons_pars->applyFormula(ModelTranslators::getAllNames(model), property.getExperiment());
-		cons_pars->status();
-
-		// Compute refined boundaries.
-		mins = cons_pars->getBounds(false);
-		maxes = cons_pars->getBounds(true);
-		rng::transform(maxes, mins, back_inserter(range_size), [](const ActLevel max, const ActLevel min) {
-			return max - min + 1;
-		});
-	}
 
 	/**
 	 * Creates transitions from labelled edges of BA and passes them to the automaton structure.
@@ -65,12 +36,7 @@ class AutomatonBuilder {
 		// Transform each edge into transition and pass it to the automaton
 		for (const PropertyAutomaton::Edge & edge : edges) {
 			// Compute allowed values from string of constrains
-			ConstraintParser * parser = new ConstraintParser(maxes.size(), *max_element(maxes.begin(), maxes.end()));
-			parser->applyFormula(names, edge.cons.values);
-			parser->addBoundaries(maxes, true);
-			parser->addBoundaries(mins, false);
-
-			automaton.addTransition(ID, { edge.target_ID, parser, edge.cons.transient, edge.cons.stable });
+			automaton.addTransition(ID, { edge.target_ID, ConstraintEvaluator(names, edge.cons.values), edge.cons.transient, edge.cons.stable });
 		}
 	}
 
@@ -91,9 +57,7 @@ class AutomatonBuilder {
 	}
 
 public:
-	AutomatonBuilder(const Model & _model, const PropertyAutomaton & _property) : model(_model), property(_property) {
-		computeBoundaries();
-	}
+	AutomatonBuilder(const Model & _model, const PropertyAutomaton & _property) : model(_model), property(_property), names(ModelTranslators::getAllNames(_model)) {}
 
 	/**
 	 * Create the transitions from the model and fill the automaton with them.
@@ -11,33 +11,22 @@
 
 #include "../auxiliary/common_functions.hpp"
 #include "../auxiliary/output_streamer.hpp"
-#include "../parsing/constraint_parser.hpp"
+#include "../parsing/constraint_evaluator.hpp"
 #include "automaton_interface.hpp"
 
 /// Single labelled transition from one state to another.
 struct AutTransitionion : public TransitionProperty {
-	mutable ConstraintParser * trans_constr; ///< Allowed values of species for this transition.
+	ConstraintEvaluator trans_constr; ///< Allowed values of species for this transition.
 	bool require_transient; ///< True if the state must be transient.
 	bool require_stable; ///< True if the state must be stable.
 
-	~AutTransitionion() {
-		if (trans_constr != nullptr)
-			delete trans_constr;
-	}
-	// Move constructor is necessary as the parent (Automaton) is passed around by moving. The memory must be kept safe.
-	AutTransitionion(AutTransitionion && other) : TransitionProperty(other.target_ID) {
-		trans_constr = other.trans_constr;
-		other.trans_constr = nullptr;
-		require_transient = other.require_transient;
-		require_stable = other.require_stable;
-		other.require_transient = other.require_stable = 0;
-	}
+	AutTransitionion(AutTransitionion &&) = default;
 	AutTransitionion& operator=(AutTransitionion &&) = delete;
 	AutTransitionion(const AutTransitionion &) = delete;
 	AutTransitionion& operator=(const AutTransitionion &) = delete;
 
-	AutTransitionion(const StateID target_ID, ConstraintParser * _trans_constr, const bool _require_transient, const bool _require_stable)
-		: TransitionProperty(target_ID), trans_constr(_trans_constr), require_transient(_require_transient), require_stable(_require_stable) {}
+	AutTransitionion(const StateID target_ID, ConstraintEvaluator _trans_constr, const bool _require_transient, const bool _require_stable)
+		: TransitionProperty(target_ID), trans_constr(move(_trans_constr)), require_transient(_require_transient), require_stable(_require_stable) {}
 };
 
 /// Storing a single state of the Buchi automaton. This state is extended with a value saying wheter the states is final.
@@ -95,8 +84,7 @@ public:
 		return states[ID].transitions[trans_no].require_transient;
 	}
 
-	// Gecode accepts only a raw pointer for the searcher.
-	ConstraintParser * getTransitionConstraint(const StateID ID, const size_t trans_no) const {
+	const ConstraintEvaluator & getTransitionConstraint(const StateID ID, const size_t trans_no) const {
 		return states[ID].transitions[trans_no].trans_constr;
 	}
 };
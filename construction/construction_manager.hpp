@@ -53,4 +53,13 @@ namespace ConstructionManager {
 		ProductStructure product = product_builder.buildProduct(move(unparametrized_structure), move(automaton));
 		return product;
 	}
+
+	/**
+	 * Remove the states of the product that can not be on any accepting path under any parametrization.
+	 */
+	void prune(ProductStructure & product) {
+		const size_t state_count = product.getStateCount();
+		ProductBuilder().pruneProduct(product);
+		output_streamer.output(verbose_str, "Product pruned to " + to_string(product.getStateCount()) + " of " + to_string(state_count) + " states.");
+	}
 }
\ No newline at end of file
@@ -18,15 +18,6 @@
 /// @attention States of product are indexed as (BA_state_ID * KS_state_count + KS_state_ID) - e.g. if 4-state KS, state ((1,0)x(1)) would be at position 4*1 + 1 = 2.
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 class ProductBuilder {
-	/* Create the copy of Unparametrized structure with the states of product with the given BA_ID. */
-	void createSubspace(const StateID BA_ID, ProductStructure & product) const {
-		for (const StateID KS_ID : crange(product.getStructure().getStateCount())) {
-			StateID ID = product.getProductID(KS_ID, BA_ID);
-			const Levels& levels = product.getStructure().getStateLevels(KS_ID);
-			product.states.push_back(ProdState(ID, KS_ID, BA_ID, false, false, levels));
-		}
-	}
-
 	/**
 	 * Label, as initial, only those states that have any outgoing transition (from all possible initials). 
 	 * In the same way, label, as accepting, under the condition that it's not a terminal automaton, the accepting states. 
@@ -36,9 +27,9 @@ class ProductBuilder {
 			for (const StateID KS_ID : crange(product.getStructure().getStateCount())) {
 				StateID ID = product.getProductID(KS_ID, BA_ID);
 				// If there's a way to leave the state
-				if ((product.states[ID].transitions.size() + product.states[ID].loops.size()) > 0) {
+				if (product.getOutDegree(ID) > 0) {
 					product.initial_states.push_back(ID);
-					product.states[ID].initial = true;
+					product.initial_marks[ID] = true;
 				}
 			}
 		}
@@ -46,53 +37,166 @@ class ProductBuilder {
 			for (const StateID KS_ID : crange(product.getStructure().getStateCount())) {
 				StateID ID = product.getProductID(KS_ID, BA_ID);
 				// If there's a way to leave the state
-				if ((product.states[ID].transitions.size() + product.states[ID].loops.size()) > 0 || (product.getAutomaton().getMyType() == BA_finite)) {
+				if (product.getOutDegree(ID) > 0 || (product.getAutomaton().getMyType() == BA_finite)) {
 					product.final_states.push_back(ID);
-					product.states[ID].final = true;
+					product.final_marks[ID] = true;
 				}
 			}
 		}
 	}
 
 	/**
-	 * Create state of the product as a combination of a single BA and a single UKS state
+	 * Evaluate the label of the edge of the BA for all the KS states.
 	 * @param BA_ID	source in the BA
-	 * @param transition_count	value which counts the transition for the whole product, will be filled
 	 */
-	void addSubspaceTransitions(const StateID BA_ID, const size_t trans_no, ProductStructure & product) const {
+	ProdEdge evaluateEdge(const StateID BA_ID, const size_t trans_no, const ProductStructure & product) const {
 		const UnparametrizedStructure & structure = product.getStructure();
 		const AutomatonStructure & automaton = product.getAutomaton();
-		StateID BA_target = automaton.getTargetID(BA_ID, trans_no);
-
-		// List through the states that are allowed by the constraint
-		DFS<ConstraintParser> search(automaton.getTransitionConstraint(BA_ID, trans_no));
-		while (ConstraintParser *result = search.next()) {
-			StateID KS_ID = structure.getID(result->getSolution());
-			StateID ID = product.getProductID(KS_ID, BA_ID);
-
-			// Add all the trasient combinations for the kripke structure
-			if (!automaton.isStableRequired(BA_ID, trans_no)) {
-				for (const size_t trans_no : crange(structure.getTransitionCount(KS_ID))) {
-					const StateID KS_target = product.getStructure().getTargetID(KS_ID, trans_no);
-					const TransConst & trans_const = product.getStructure().getTransitionConst(KS_ID, trans_no);
-					product.states[ID].transitions.push_back({ product.getProductID(KS_target, BA_target), trans_const });
+		ProdEdge edge = { BA_ID, automaton.getTargetID(BA_ID, trans_no), !automaton.isStableRequired(BA_ID, trans_no), !automaton.isTransientRequired(BA_ID, trans_no),
+		                  vector<bool>(structure.getStateCount(), false) };
+
+		// The states of the structure are numbered the same way as the evaluator scans its space.
+		automaton.getTransitionConstraint(BA_ID, trans_no).markStates(structure.getMins(), structure.getMaxes(), edge.guard);
+		return edge;
+	}
+
+	/* Index the KS transitions by their targets - counted first, then filled in the order of the sources, so that they stay sorted. */
+	void indexKSPredecessors(ProductStructure & product) const {
+		const UnparametrizedStructure & structure = product.getStructure();
+		product.KS_preds_begin.assign(structure.getStateCount() + 1, 0);
+		for (const StateID KS_ID : crange(structure.getStateCount()))
+			structure.forEachTransition(KS_ID, [&product](const StateID KS_target, const TransConst &) { product.KS_preds_begin[KS_target + 1]++; });
+		partial_sum(product.KS_preds_begin.begin(), product.KS_preds_begin.end(), product.KS_preds_begin.begin());
+
+		product.KS_predecessors.assign(product.KS_preds_begin.back(), { INF, TransConst() });
+		vector<size_t> preds_end(product.KS_preds_begin.begin(), product.KS_preds_begin.end() - 1);
+		for (const StateID KS_ID : crange(structure.getStateCount()))
+			structure.forEachTransition(KS_ID, [&](const StateID KS_target, const TransConst & trans_const) {
+				product.KS_predecessors[preds_end[KS_target]++] = { KS_ID, trans_const };
+			});
+	}
+
+	/* Index the transitions and loops by their targets - a transition for each KS transition leading to the KS state and each transient edge leading
+	   to the BA state, a loop for each stable edge leading to the BA state, if the source satisfies the label and has not been removed. */
+	void indexPredecessors(ProductStructure & product) const {
+		// The indices are packed into 32 bits to halve the size of the index.
+		const size_t max_index = numeric_limits<unsigned int>::max();
+		if (product.getStateCount() > max_index || product.KS_predecessors.size() > max_index)
+			throw runtime_error("The product of " + to_string(product.getStateCount()) + " states and " + to_string(product.KS_predecessors.size())
+				+ " transitions of the Kripke structure is too large to be indexed.");
+
+		vector<vector<const ProdEdge *> > in_edges(product.edges.size());
+		for (const vector<ProdEdge> & BA_edges : product.edges)
+			for (const ProdEdge & edge : BA_edges)
+				in_edges[edge.BA_target].push_back(&edge);
+
+		product.preds_begin.assign(1, 0);
+		product.predecessors.clear();
+		product.loop_preds_begin.assign(1, 0);
+		product.loop_preds.clear();
+		for (const StateID ID : crange(product.getStateCount())) {
+			const StateID KS_ID = product.getKSID(ID);
+			for (const ProdEdge * edge : in_edges[product.getBAID(ID)]) {
+				for (const size_t KS_pred_no : crange(product.KS_preds_begin[KS_ID], product.KS_preds_begin[KS_ID + 1])) {
+					const StateID KS_source = product.KS_predecessors[KS_pred_no].source_ID;
+					const StateID source_ID = product.getProductID(KS_source, edge->BA_source);
+					if (edge->transient && edge->guard[KS_source] && source_ID != INF)
+						product.predecessors.push_back({ static_cast<unsigned int>(source_ID), static_cast<unsigned int>(KS_pred_no) });
 				}
 			}
-			// Add a self-loop
-			if (!automaton.isTransientRequired(BA_ID, trans_no)) 
-				product.states[ID].loops.push_back(product.getProductID(KS_ID, BA_target));
-
-			delete result;
+			for (const ProdEdge * edge : in_edges[product.getBAID(ID)]) {
+				const StateID source_ID = product.getProductID(KS_ID, edge->BA_source);
+				if (edge->stable && edge->guard[KS_ID] && source_ID != INF)
+					product.loop_preds.push_back(static_cast<unsigned int>(source_ID));
+			}
+			if (product.predecessors.size() > max_index || product.loop_preds.size() > max_index)
+				throw runtime_error("The product has more than " + to_string(max_index) + " transitions, it is too large to be indexed.");
+			product.preds_begin.push_back(static_cast<unsigned int>(product.predecessors.size()));
+			product.loop_preds_begin.push_back(static_cast<unsigned int>(product.loop_preds.size()));
 		}
+		product.predecessors.shrink_to_fit();
+		product.loop_preds.shrink_to_fit();
 	}
 
+	/**
+	 * Mark the states reachable from the sources, each transition and loop is considered open.
+	 * @param forward	follow the transitions forward, otherwise backward
+	 * @param allowed	only the states marked here are entered
+	 */
+	static vector<bool> reachAll(const ProductStructure & product, const vector<StateID> & sources, const bool forward, const vector<bool> & allowed) {
+		vector<bool> reached(product.getStateCount(), false);
+		vector<StateID> stack;
+		auto visit = [&](const StateID ID) {
+			if (allowed[ID] && !reached[ID]) {
+				reached[ID] = true;
+				stack.push_back(ID);
+			}
+		};
+		for_each(sources.begin(), sources.end(), visit);
+		while (!stack.empty()) {
+			const StateID ID = stack.back();
+			stack.pop_back();
+			if (forward) {
+				product.forEachTransition(ID, [&visit](const StateID target_ID, const TransConst &) { visit(target_ID); });
+				product.forEachLoop(ID, visit);
+			}
+			else {
+				product.forEachPredecessor(ID, [&visit](const StateID source_ID, const TransConst &) { visit(source_ID); });
+				product.forEachLoopPredecessor(ID, visit);
+			}
+		}
+		return reached;
+	}
 
 public:
+	/**
+	 * Remove the states that are not reachable from an initial state or from which no final state is reachable, even if all the transitions are open.
+	 * Those can not be on any path the synthesis searches for. The remaining states keep their order and are renumbered.
+	 * The initial states are all kept, as the robustness is divided between all of them.
+	 */
+	void pruneProduct(ProductStructure & product) const {
+		const vector<bool> reachable = reachAll(product, product.initial_states, true, vector<bool>(product.getStateCount(), true));
+		vector<bool> alive = reachAll(product, product.final_states, false, reachable);
+		for (const StateID ID : product.initial_states)
+			alive[ID] = true;
+		if (find(alive.begin(), alive.end(), false) == alive.end())
+			return;
+
+		vector<StateID> pruned_IDs(product.getStateCount(), INF);
+		vector<ProdState> states;
+		vector<bool> initial_marks, final_marks;
+		for (const StateID ID : crange(product.getStateCount())) {
+			if (!alive[ID])
+				continue;
+			pruned_IDs[ID] = states.size();
+			states.push_back(ProdState(product.getOriginalID(ID), product.getKSID(ID), product.getBAID(ID), product.isInitial(ID), product.isFinal(ID), product.getStateLevels(ID)));
+			initial_marks.push_back(product.initial_marks[ID]);
+			final_marks.push_back(product.final_marks[ID]);
+		}
+
+		// The transitions and loops that lead to removed states are skipped when composed, those from removed states are dropped from the predecessors.
+		auto renumber = [&pruned_IDs, &alive](vector<StateID> & IDs) {
+			IDs.erase(remove_if(IDs.begin(), IDs.end(), [&alive](const StateID ID) { return !alive[ID]; }), IDs.end());
+			for (StateID & ID : IDs)
+				ID = pruned_IDs[ID];
+		};
+		renumber(product.initial_states);
+		renumber(product.final_states);
+
+		product.states = move(states);
+		product.initial_marks = move(initial_marks);
+		product.final_marks = move(final_marks);
+		product.pruned_IDs = move(pruned_IDs);
+		indexPredecessors(product);
+	}
+
 	/**
 	 * Create the the synchronous product of the provided BA and UKS.
 	 */
-	ProductStructure buildProduct(UnparametrizedStructure  _structure, AutomatonStructure  _automaton) const {
+	ProductStructure buildProduct(UnparametrizedStructure  _structure, AutomatonStructure  _automaton) {
 		ProductStructure product(move(_structure), move(_automaton));
+		product.initial_marks.assign(product.getStateCount(), false);
+		product.final_marks.assign(product.getStateCount(), false);
 
 		// Creates states and their transitions
 		for (size_t BA_ID = 0; BA_ID < product.getAutomaton().getStateCount(); BA_ID++) {
@@ -100,13 +204,15 @@ public:
 				+ to_string(product.getAutomaton().getStateCount()) + ".", OutputStreamer::no_newl | OutputStreamer::rewrite_ln);
 
 			// Create that what relates to this BA state
-			createSubspace(BA_ID, product);
-			for (const size_t trans_no : crange(product.getAutomaton().getTransitionCount(BA_ID))) 
-				addSubspaceTransitions(BA_ID, trans_no, product);
+			product.edges.emplace_back();
+			for (const size_t trans_no : crange(product.getAutomaton().getTransitionCount(BA_ID)))
+				product.edges.back().push_back(evaluateEdge(BA_ID, trans_no, product));
 			relabel(BA_ID, product);
 		}
 
 		output_streamer.clear_line(verbose_str);
+		indexKSPredecessors(product);
+		indexPredecessors(product);
 
 		return product;
 	}
@@ -14,24 +14,40 @@
 #include "../construction/unparametrized_structure.hpp"
 #include "transition_system_interface.hpp"
 
-/// Storing a single transition to neighbour state together with its transition function.
-struct ProdTransitionion : public TransitionProperty {
-	const TransConst & trans_const;
+/// Edge of the BA with its label evaluated for all the KS states, so that the transitions of the product are composed without the constraint parser.
+struct ProdEdge {
+	StateID BA_source; ///< Source of the edge in the BA.
+	StateID BA_target; ///< Target of the edge in the BA.
+	bool transient; ///< True if the KS state may be left along the edge, i.e. a stable state is not required.
+	bool stable; ///< True if the KS state may be kept along the edge, i.e. a transient state is not required.
+	vector<bool> guard; ///< guard[KS_ID] is true iff the KS state satisfies the label of the edge.
+};
+
+/// Transition of the KS stored with its target - the source together with a copy of the constraint, so that the predecessors can be stored packed.
+struct KSPredecessor {
+	StateID source_ID;
+	TransConst trans_const;
+};
 
-	ProdTransitionion(const StateID _target_ID, const TransConst & _trans_const)
-		: TransitionProperty(_target_ID), trans_const(_trans_const) {}
+/// Transition of the product stored with its target - the source and the position of the KS transition it is composed of, which holds the constraint.
+/// Both are packed into 32 bits, the ProductBuilder refuses to index larger products.
+struct ProdPredecessor {
+	unsigned int source_ID;
+	unsigned int KS_pred_no;
 };
 
-/// State of the product - same as the state of UKS but put together with a BA state.
-struct ProdState : public AutomatonStateProperty<ProdTransitionion> {
+/// State of the product that has remained after pruning - same as the state of UKS but put together with a BA state. Transitions are composed by the ProductStructure.
+struct ProdState {
+	const StateID ID; ///< Unique ID of the state, (BA_ID * KS_state_count + KS_ID) even if the product has been pruned.
+	bool initial; ///< True if the state is initial.
+	bool final; ///< True if this state is final.
 	const StateID KS_ID; ///< ID of an original KS state this one is built from
 	const StateID BA_ID; ///< ID of an original BA state this one is built from
 	const Levels & levels; ///< species_level[i] = activation level of specie i in this state
-	vector<StateID> loops; ///< States with the Same KS ID, but different BA that are possible targets
 
 	/// Simple filler, assigns values to all the variables
-	ProdState(const StateID ID, const StateID _KS_ID, const StateID _BA_ID, const bool initial, const bool final, const Levels & _species_level)
-		: AutomatonStateProperty<ProdTransitionion>(initial, final, ID), KS_ID(_KS_ID), BA_ID(_BA_ID), levels(_species_level) {}
+	ProdState(const StateID _ID, const StateID _KS_ID, const StateID _BA_ID, const bool _initial, const bool _final, const Levels & _species_level)
+		: ID(_ID), initial(_initial), final(_final), KS_ID(_KS_ID), BA_ID(_BA_ID), levels(_species_level) {}
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -40,16 +56,41 @@ struct ProdState : public AutomatonStateProperty<ProdTransitionion> {
 /// This is the final step of construction - a structure that is acutally used during the computation. For simplicity, it copies data from its predecessors (BA and UKS).
 /// @attention States of product are indexed as (BA_state_count * KS_state_ID + BA_state_ID) - e.g. if 3-state BA state ((1,0)x(1)) would be at position 3*1 + 1 = 4.
 ///
+/// Transitions and loops are not stored, they are composed on the fly from the transitions of the KS state and the edges of the BA state
+/// whose labels the KS state satisfies - a transition for each pair of a KS transition and an edge that does not require a stable state,
+/// a loop for each edge that does not require a transient state. The labels are evaluated once for all the KS states when the product is built.
+/// The transitions and loops indexed by their targets are frozen in the compressed sparse row form - those of the state ID are stored
+/// in [begin[ID], begin[ID + 1]) of a single packed vector, which allows to search the predecessors of a state.
+/// A transition keeps only its source and the position of its KS transition, the constraints are stored once for all the BA states
+/// among the KS transitions indexed the same way.
+///
+/// The states are not stored, the KS and BA states are obtained from the ID itself, only the initial and final ones are marked.
+/// If the product has been pruned, the states that can not be on any accepting path are removed and the rest keep their order,
+/// their positions are then obtained by getProductID and their original numbers by getOriginalID - only then the remaining states are stored.
+///
 /// ProductStructure data can be set only from the ProductBuilder object.
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-class ProductStructure : public AutomatonInterface<ProdState>, public TSInterface<ProdState> {
+class ProductStructure : public AutomatonInterface<ProdState> {
 	friend class ProductBuilder;
 	UnparametrizedStructure structure;
 	AutomatonStructure automaton;
+	size_t KS_count = 0; ///< Number of the KS states, the states of the product are numbered by it.
+
+	vector<vector<ProdEdge> > edges; ///< Edges of each BA state with their labels evaluated.
+	vector<size_t> KS_preds_begin; ///< Index of the first predecessor of each KS state, the last value is the total number of KS transitions.
+	vector<KSPredecessor> KS_predecessors; ///< Sources of the transitions of all the KS states, one target after another.
+	vector<unsigned int> preds_begin; ///< Index of the first predecessor of each state, the last value is the total number of transitions.
+	vector<ProdPredecessor> predecessors; ///< Sources of the transitions of all the states, one target after another.
+	vector<unsigned int> loop_preds_begin; ///< Index of the first loop predecessor of each state, the last value is the total number of loops.
+	vector<unsigned int> loop_preds; ///< Sources of the loops of all the states, one target after another.
+	vector<StateID> pruned_IDs; ///< Position of the state with each original number, INF if it has been removed. Empty if the product has not been pruned.
+	vector<bool> initial_marks; ///< initial_marks[ID] is true iff the state is initial.
+	vector<bool> final_marks; ///< final_marks[ID] is true iff the state is final.
 
 public:
 	ProductStructure() = default;
 	ProductStructure(UnparametrizedStructure _structure, AutomatonStructure _automaton) : structure(move(_structure)), automaton(move(_automaton)) {
+		KS_count = structure.getStateCount();
 		my_type = _automaton.getMyType();
 	}
 	ProductStructure(ProductStructure &&) = default;
@@ -58,7 +99,18 @@ public:
 	ProductStructure& operator=(ProductStructure && other) {
 		structure = move(other.structure);
 		automaton = move(other.automaton);
+		KS_count = other.KS_count;
 		states = move(other.states);
+		edges = move(other.edges);
+		KS_preds_begin = move(other.KS_preds_begin);
+		KS_predecessors = move(other.KS_predecessors);
+		preds_begin = move(other.preds_begin);
+		predecessors = move(other.predecessors);
+		loop_preds_begin = move(other.loop_preds_begin);
+		loop_preds = move(other.loop_preds);
+		pruned_IDs = move(other.pruned_IDs);
+		initial_marks = move(other.initial_marks);
+		final_marks = move(other.final_marks);
 		my_type = other.my_type;
 		initial_states = move(other.initial_states);
 		final_states = move(other.final_states);
@@ -73,26 +125,160 @@ public:
 		return automaton;
 	}
 
+	/**
+	 * @return the state with the given KS and BA states, INF if it has been pruned
+	 */
 	inline StateID getProductID(const StateID KS_ID, const StateID BA_ID) const {
-		return (BA_ID * structure.getStateCount() + KS_ID);
+		const StateID ID = BA_ID * KS_count + KS_ID;
+		return pruned_IDs.empty() ? ID : pruned_IDs[ID];
+	}
+
+	/**
+	 * @return the number of the states, those that have been pruned are not counted
+	 */
+	inline size_t getStateCount() const {
+		return pruned_IDs.empty() ? KS_count * automaton.getStateCount() : states.size();
+	}
+
+	/**
+	 * @return the number the state would have in the product without pruning
+	 */
+	inline StateID getOriginalID(const StateID ID) const {
+		return pruned_IDs.empty() ? ID : states[ID].ID;
 	}
 
 	inline StateID getBAID(const StateID ID) const {
-		return states[ID].BA_ID;
+		return pruned_IDs.empty() ? ID / KS_count : states[ID].BA_ID;
 	}
 
 	inline StateID getKSID(const StateID ID) const {
-		return states[ID].KS_ID;
+		return pruned_IDs.empty() ? ID % KS_count : states[ID].KS_ID;
+	}
+
+	inline bool isInitial(const StateID ID) const override {
+		return initial_marks[ID];
+	}
+
+	inline bool isFinal(const StateID ID) const override {
+		return final_marks[ID];
+	}
+
+	/**
+	 * Call visit(target_ID, trans_const) for each transition of the state, those leading to the pruned states are skipped.
+	 */
+	template <class Visitor>
+	void forEachTransition(const StateID ID, Visitor && visit) const {
+		const StateID KS_ID = getKSID(ID);
+		for (const ProdEdge & edge : edges[getBAID(ID)]) {
+			if (!edge.transient || !edge.guard[KS_ID])
+				continue;
+			structure.forEachTransition(KS_ID, [this, &edge, &visit](const StateID KS_target, const TransConst & trans_const) {
+				const StateID target_ID = getProductID(KS_target, edge.BA_target);
+				if (target_ID != INF)
+					visit(target_ID, trans_const);
+			});
+		}
+	}
+
+	/**
+	 * Call visit(target_ID) for each BA successor of the state that shares its KS state, the pruned ones are skipped.
+	 */
+	template <class Visitor>
+	void forEachLoop(const StateID ID, Visitor && visit) const {
+		const StateID KS_ID = getKSID(ID);
+		for (const ProdEdge & edge : edges[getBAID(ID)]) {
+			if (!edge.stable || !edge.guard[KS_ID])
+				continue;
+			const StateID target_ID = getProductID(KS_ID, edge.BA_target);
+			if (target_ID != INF)
+				visit(target_ID);
+		}
+	}
+
+	size_t getTransitionCount(const StateID ID) const {
+		size_t count = 0;
+		forEachTransition(ID, [&count](const StateID, const TransConst &) { count++; });
+		return count;
+	}
+
+	size_t getLoopCount(const StateID ID) const {
+		size_t count = 0;
+		forEachLoop(ID, [&count](const StateID) { count++; });
+		return count;
+	}
+
+	/**
+	 * @return the number of the transitions and loops leaving the state, without composing them, so those leading to the pruned states are included
+	 */
+	inline size_t getOutDegree(const StateID ID) const {
+		const StateID KS_ID = getKSID(ID);
+		size_t degree = 0;
+		for (const ProdEdge & edge : edges[getBAID(ID)])
+			if (edge.guard[KS_ID])
+				degree += (edge.transient ? structure.getTransitionCount(KS_ID) : 0) + (edge.stable ? 1 : 0);
+		return degree;
+	}
+
+	inline const Levels & getStateLevels(const StateID ID) const {
+		return structure.getStateLevels(getKSID(ID));
+	}
+
+	/**
+	 * @return the number of the transitions and loops leading to the state
+	 */
+	inline size_t getInDegree(const StateID ID) const {
+		return preds_begin[ID + 1] - preds_begin[ID] + loop_preds_begin[ID + 1] - loop_preds_begin[ID];
+	}
+
+	/**
+	 * @return the total number of the transitions and loops
+	 */
+	inline size_t getPredecessorCount() const {
+		return predecessors.size() + loop_preds.size();
+	}
+
+	/**
+	 * @return true if test(source_ID, trans_const) holds for some transition leading to the state, the search stops at the first such one
+	 */
+	template <class Test>
+	bool anyPredecessor(const StateID ID, Test && test) const {
+		for (const ProdPredecessor & pred : boost::make_iterator_range(predecessors.begin() + preds_begin[ID], predecessors.begin() + preds_begin[ID + 1]))
+			if (test(pred.source_ID, KS_predecessors[pred.KS_pred_no].trans_const))
+				return true;
+		return false;
+	}
+
+	/**
+	 * @return true if test(source_ID) holds for some state that has the state among its loops, the search stops at the first such one
+	 */
+	template <class Test>
+	bool anyLoopPredecessor(const StateID ID, Test && test) const {
+		for (const unsigned int source_ID : boost::make_iterator_range(loop_preds.begin() + loop_preds_begin[ID], loop_preds.begin() + loop_preds_begin[ID + 1]))
+			if (test(source_ID))
+				return true;
+		return false;
+	}
+
+	/**
+	 * Call visit(source_ID, trans_const) for each transition leading to the state.
+	 */
+	template <class Visitor>
+	void forEachPredecessor(const StateID ID, Visitor && visit) const {
+		anyPredecessor(ID, [&visit](const StateID source_ID, const TransConst & trans_const) { visit(source_ID, trans_const); return false; });
 	}
 
-	inline const vector<StateID> & getLoops(const StateID ID) const {
-		return states[ID].loops;
+	/**
+	 * Call visit(source_ID) for each state that has the state among its loops.
+	 */
+	template <class Visitor>
+	void forEachLoopPredecessor(const StateID ID, Visitor && visit) const {
+		anyLoopPredecessor(ID, [&visit](const StateID source_ID) { visit(source_ID); return false; });
 	}
 
 	const string getString(const StateID ID) const {
 		string label = "(";
 
-		for (const ActLevel lev : states[ID].levels)
+		for (const ActLevel lev : getStateLevels(ID))
 			label += to_string(lev) + ",";
 
 		label[label.length() - 1] = ';';
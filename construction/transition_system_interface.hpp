@@ -11,20 +11,25 @@
 
 #include "graph_interface.hpp"
 
+/// Regulatory context (a kinetic parameter) of a specie whose value controls some transitions within a TS
+struct TransContext {
+   ParamNo step_size; ///< How many bits of a parameter space bitset is needed to get from one targe value to another.
+   const Levels & targets; ///< Values of the targets for different parameters for this specie.
+};
+
 /// Structure with constraints on a transition within a TS
 struct TransConst {
-   ParamNo step_size; ///< How many bits of a parameter space bitset is needed to get from one targe value to another.
+   size_t context; ///< Index of the regulatory context that controls this transition.
    bool req_dir; ///< true for increase, false for decrease
    ActLevel comp_value; ///< value of the specie that's being questioned
-   const Levels & targets; ///< Values of the targets for different parameters for this specie.
 };
 
 /// Storing a single transition to neighbour state together with its transition function.
 struct TSTransitionProperty : public TransitionProperty {
    TransConst trans_const;
 
-   TSTransitionProperty(const StateID target_ID, const ParamNo _step_size, const bool _req_op, const ActLevel _req_comp, const Levels & _targets)
-      : TransitionProperty(target_ID), trans_const({_step_size, _req_op, _req_comp, _targets}) {}
+   TSTransitionProperty(const StateID target_ID, const size_t _context, const bool _req_op, const ActLevel _req_comp)
+      : TransitionProperty(target_ID), trans_const({_context, _req_op, _req_comp}) {}
 };
 
 /// State having specie levels attached.
@@ -50,6 +55,15 @@ public:
       return GraphInterface<StateT>::states[ID].transitions[trans_no].trans_const;
    }
 
+   /**
+    * Call visit(target_ID, trans_const) for each transition of the state.
+    */
+   template <class Visitor>
+   void forEachTransition(const StateID ID, Visitor && visit) const {
+      for (const TSTransitionProperty & transition : GraphInterface<StateT>::states[ID].transitions)
+         visit(transition.target_ID, transition.trans_const);
+   }
+
    /**
     * @brief getStateLevels return reference to activity levels of this state
     * @param ID of the state
@@ -18,7 +18,7 @@
 ///
 /// UnparametrizedStructure stores states of the Kripke structure created from the model together with labelled transitions.
 /// Each transition contains a function that causes it with explicit enumeration of values from the function that are transitive.
-/// To easily search for the values in the parameter bitmask, step_size of the function is added
+/// To easily search for the values in the parameter bitmask, each transition references a context that holds step_size of the function
 /// - that is the value saying how many bits of mask share the the same value for the function.
 /// UnparametrizedStructure data can be set only from the UnparametrizedStructureBuilder object.
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -28,6 +28,7 @@ class UnparametrizedStructure : public TSInterface<TSStateProperty> {
 	Levels maxes; ///< Maximal activity levels of the species.
 	Levels mins; ///< Minimal activity levels of the species.
 	Levels range_size; ///< Differences between the two.
+	vector<TransContext> contexts; ///< Regulatory contexts of all the species, referenced by the transitions.
 
 public:
 	UnparametrizedStructure() = default;
@@ -36,6 +37,10 @@ public:
 	UnparametrizedStructure& operator=(const UnparametrizedStructure &) = delete;
 	UnparametrizedStructure& operator=(UnparametrizedStructure && other) {
 		states = move(other.states);
+		maxes = move(other.maxes);
+		mins = move(other.mins);
+		range_size = move(other.range_size);
+		contexts = move(other.contexts);
 		return *this;
 	}
 
@@ -51,8 +56,23 @@ public:
 	 * @param ID	add data to the state with this IS
 	 * Add a new transition to the source specie, containg necessary edge labels for the CMC
 	 */
-	inline void addTransition(const StateID ID, const StateID target_ID, const ParamNo step_size, const bool _dir, const ActLevel level, const Levels & targets) {
-		GraphInterface<TSStateProperty>::states[ID].transitions.push_back(TSTransitionProperty(target_ID, step_size, _dir, level, targets));
+	inline void addTransition(const StateID ID, const StateID target_ID, const size_t context, const bool _dir, const ActLevel level) {
+		GraphInterface<TSStateProperty>::states[ID].transitions.push_back(TSTransitionProperty(target_ID, context, _dir, level));
+	}
+
+	/**
+	 * @return regulatory contexts indexed by TransConst::context
+	 */
+	inline const vector<TransContext> & getContexts() const {
+		return contexts;
+	}
+
+	inline const Levels & getMins() const {
+		return mins;
+	}
+
+	inline const Levels & getMaxes() const {
+		return maxes;
 	}
 
 	inline StateID getID(const Levels & levels) const {
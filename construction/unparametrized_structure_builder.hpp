@@ -11,6 +11,7 @@
 
 #include "unparametrized_structure.hpp"
 #include "../model/model_translators.hpp"
+#include "../parsing/constraint_evaluator.hpp"
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// \brief Creates a UnparametrizedStructure as a composition of a BasicStructure and ParametrizationsHolder.
@@ -27,6 +28,7 @@ class UnparametrizedStructureBuilder {
 
 	vector<size_t> index_jumps; ///< Holds index differences between two neighbour states in each direction for each specie.
 	vector<bool> allowed_states; ///< Masking the states (by IDs) that are allowed by the current experiment
+	vector<size_t> context_offsets; ///< Index of the first context of each specie within the contexts of the structure.
 
 	/**
 	 * @return Returns true if the transition may be ever feasible from this state.
@@ -53,13 +55,11 @@ class UnparametrizedStructureBuilder {
 	void addTransition(const StateID ID, const StateID target, const SpecieID specie, const bool direction, const Levels & state_levels, UnparametrizedStructure & structure) {
 		// Find out which function is currently active
 		const size_t fun_no = getActiveFunction(specie, state_levels);
-		// Fill the step size
-		const ParamNo step_size = kinetics.species[specie].step_size;
 		// Reference target values
 		const Levels & parameter_vals = kinetics.species[specie].params[fun_no].target_in_subcolor;
 
 		if (isFeasible(parameter_vals, direction, state_levels[specie]))
-			structure.addTransition(ID, target, step_size, direction, state_levels[specie], parameter_vals);
+			structure.addTransition(ID, target, context_offsets[specie] + fun_no, direction, state_levels[specie]);
 	}
 
 	/**
@@ -129,6 +129,17 @@ class UnparametrizedStructureBuilder {
 		}
 	}
 
+	/**
+	 * Create a context for each kinetic parameter, species are stored one after another.
+	 */
+	void addContexts(UnparametrizedStructure & structure) {
+		for (const Kinetics::Specie & specie : kinetics.species) {
+			context_offsets.emplace_back(structure.contexts.size());
+			for (const Kinetics::Param & param : specie.params)
+				structure.contexts.push_back({ specie.step_size, param.target_in_subcolor });
+		}
+	}
+
 	/* Prepare the data structure that stores IDs of allowed states. */
 	void prepareAllowed(const UnparametrizedStructure & structure, const size_t state_count, const bool init) {
 		if (state_count * property.getStatesCount() > structure.states.max_size())
@@ -143,10 +154,6 @@ class UnparametrizedStructureBuilder {
 		structure.mins = bounds.first; structure.maxes = bounds.second;
 		rng::transform(structure.maxes, structure.mins, back_inserter(structure.range_size), [](const ActLevel max, const ActLevel min) {return max - min + 1;});
 
-		ConstraintParser * cons_pars = new ConstraintParser(model.species.size(), ModelTranslators::getMaxLevel(model));
-		cons_pars->addBoundaries(bounds.first, false);
-		cons_pars->addBoundaries(bounds.second, true);
-		cons_pars->applyFormula(ModelTranslators::getAllNames(model), property.getExperiment());
 		// Compute distances between neighbours
 		computeJumps(structure.range_size);
 
@@ -155,15 +162,10 @@ class UnparametrizedStructureBuilder {
 		bool all_states = property.getExperiment() == "tt";
 		prepareAllowed(structure, state_count, all_states);
 
-		// Conduct search
+		// Scan the states in the order of their IDs
 		if (!all_states) {
-			DFS<ConstraintParser> search(cons_pars);
-			delete cons_pars;
-			while (ConstraintParser *result = search.next()) {
-				StateID ID = structure.getID(result->getSolution());
-				allowed_states[ID] = true;
-				delete result;
-			}
+			const ConstraintEvaluator experiment(ModelTranslators::getAllNames(model), property.getExperiment());
+			experiment.markStates(structure.mins, structure.maxes, allowed_states);
 		}
 
 		return state_count;
@@ -178,6 +180,7 @@ public:
 	 */
 	UnparametrizedStructure buildStructure() {
 		UnparametrizedStructure structure;
+		addContexts(structure);
 
 		// Create states
 		size_t state_no = 0;
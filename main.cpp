@@ -21,20 +21,48 @@
 #include "construction/construction_manager.hpp"
 #include "construction/product_builder.hpp"
 #include "synthesis/synthesis_manager.hpp"
+#include "synthesis/minimal_buffer.hpp"
+#include "synthesis/parallel_manager.hpp"
+#include "synthesis/process_manager.hpp"
+#include "synthesis/parallel_planner.hpp"
+#include "synthesis/symbolic_checker.hpp"
 
 /**
- * @brief checkDepthBound see if there is not a new BFS depth bound
+ * @brief synthesizeSymbolic check all the parametrizations at once, they are enumerated only if an output is requested as the space may be too large for it
+ * @return number of the parametrizations that were considered satisfiable
  */
-void checkDepthBound(const bool minimalize_cost, const size_t depth, SplitManager & split_manager, OutputManager & output, size_t & BFS_bound, ParamNo & valid_param_count) {
-	if (depth < BFS_bound && minimalize_cost) {
-		// Reset the outputs if better was found.
-		output_streamer.clear_line(verbose_str);
-		split_manager.setStartPositions();
-		output.eraseData();
-		output_streamer.output(verbose_str, "New lowest bound on Cost has been found. Restarting the computation. The current Cost is: " + to_string(depth));
-		valid_param_count = 0;
-		BFS_bound = depth;
+ParamNo synthesizeSymbolic(const UserOptions & user_options, const ProductStructure & product, const Kinetics & kinetics, OutputManager & output) {
+	typedef DecisionDiagram::Node Node;
+	SymbolicChecker checker(product, kinetics);
+	DecisionDiagram & diagram = checker.getDiagram();
+	vector<Node> costs = checker.computeCosts(user_options.bound_size);
+
+	// Only the lowest Cost is kept if the Cost is minimized.
+	if (user_options.minimalize_cost) {
+		auto lowest = find_if(costs.begin(), costs.end(), [](const Node params) { return params != DecisionDiagram::EMPTY; });
+		costs.erase(lowest == costs.end() ? lowest : lowest + 1, costs.end());
+	}
+	Node accepted = DecisionDiagram::EMPTY;
+	for (const Node params : costs)
+		accepted = diagram.disjoin(accepted, params);
+	const Node reported = user_options.produce_negative ? diagram.subtract(DecisionDiagram::FULL, accepted) : accepted;
+	output_streamer.output(verbose_str, "Decision diagram of " + to_string(diagram.getNodeCount()) + " nodes.");
+
+	if (user_options.output_console || user_options.use_textfile || user_options.use_database) {
+		size_t param_ID = 1;
+		diagram.forEach(reported, [&](const ParamNo param_no) {
+			size_t cost = INF;
+			for (const size_t level : cscope(costs)) {
+				if (diagram.contains(costs[level], param_no)) {
+					cost = level;
+					break;
+				}
+			}
+			output.outputRound(param_ID++, param_no, cost, 0., "");
+		});
 	}
+
+	return diagram.count(reported);
 }
 
 /**
@@ -57,8 +85,6 @@ int main(int argc, const char* argv[]) {
 	try {
 		user_options = ParsingManager::parseOptions(argc, argv);
 		output_streamer.setOptions(user_options);
-		if (user_options.produce_negative & (user_options.analysis() | user_options.minimalize_cost | (user_options.bound_size != INF)))
-			throw runtime_error("The switch -n can not be used together with -m, -W, -w, -r, --bound as it produces only parametrizations that do not allow accepting by the automaton.");
 	}
 	catch (std::exception & e) {
 		output_streamer.output(error_str, "Error occured while parsing arguments: \"" + string(e.what()) + "\".\n Call \"parsybone --help\" for usage.");
@@ -89,58 +115,160 @@ int main(int argc, const char* argv[]) {
 		for (const string & filter_name : user_options.filter_databases) 
 			filter.prepare(kinetics, filter_name);
 		product = ConstructionManager::construct(model, property, kinetics);
+		ConstructionManager::prune(product);
 	}
 	catch (std::exception & e) {
 		output_streamer.output(error_str, string("Error occured while building the data structures: \"" + string(e.what()) + "\". \n Contact support for details."));
 		return 4;
 	}
 
+	// Symbolic synthesis of all the parametrizations at once
+	if (user_options.use_symbolic) {
+		try {
+			if (property.isCountingUsed())
+				throw runtime_error("The symbolic synthesis does not support counting of the accepting states.");
+			OutputManager output(user_options, property, model, kinetics);
+			output.outputForm();
+			const ParamNo param_count = synthesizeSymbolic(user_options, product, kinetics, output);
+			output.outputSummary(param_count, KineticsTranslators::getSpaceSize(kinetics));
+		}
+		catch (std::exception & e) {
+			output_streamer.output(error_str, string("Error occured while syntetizing the parametrizations: \"" + string(e.what()) + "\".\n Contact support for details."));
+			return 5;
+		}
+
+		if (user_options.be_verbose)
+			time_manager.writeClock("* Runtime");
+		return 0;
+	}
+
 	// Synthesis of parametrizations
 	try {
-		SplitManager split_manager(user_options.processes_count, user_options.process_number, KineticsTranslators::getSpaceSize(kinetics));
+		if (user_options.plan_parallel) {
+			// The share of this process, the block size is not known yet.
+			SplitManager process_share(user_options.processes_count, user_options.process_number, KineticsTranslators::getSpaceSize(kinetics));
+			process_share.computeSubspace();
+			ParallelPlanner planner(product, property, user_options);
+			const ParallelPlan plan = planner.plan(process_share.getProcColorsCount());
+			user_options.threads_count = plan.threads_count;
+			user_options.bfs_threads_count = plan.bfs_threads_count;
+			user_options.block_size = plan.block_size;
+			output_streamer.output(verbose_str, planner.getReport());
+		}
+		// The windows of intervals are used for the blocks, the rounds stay of the block size.
+		if (user_options.interval_size > 0 && user_options.block_size == 1)
+			user_options.block_size = MASK_WIDTH;
+		const auto synthesis_start = chrono::steady_clock::now();
+		SplitManager split_manager(user_options.processes_count, user_options.process_number, KineticsTranslators::getSpaceSize(kinetics), user_options.block_size);
+		if (user_options.use_gray) {
+			vector<ParamNo> radices;
+			for (const Kinetics::Specie & specie : kinetics.species)
+				radices.push_back(specie.col_count);
+			split_manager.setGrayCode(radices);
+		}
 		split_manager.computeSubspace();
 		OutputManager output(user_options, property, model, kinetics);
 		SynthesisManager synthesis_manager(product);
+		synthesis_manager.setBFSThreads(user_options.bfs_threads_count);
 		ParamNo param_count = 0ul; ///< Number of parametrizations that were considered satisfiable.
 		size_t BFS_bound = user_options.bound_size; ///< Maximal cost on the verified property.
 		output.outputForm();
 		size_t param_ID = 1;
+		MinimalBuffer minimal(BFS_bound); ///< With cost minimization, the parametrizations are output only once the lowest Cost is known.
+
+		// Members of the round that are allowed by the filter.
+		auto getMembers = [&](const RoundNo round_no) -> ParamMask {
+			const ParamNo first = split_manager.getParamNo(round_no);
+			ParamMask members = 0;
+			for (const size_t member : crange(split_manager.getRoundSize(first)))
+				if (filter.isAllowed(kinetics, first + member))
+					members |= static_cast<ParamMask>(1) << member;
+			return members;
+		};
+
+		// With multiple threads or worker processes, the rounds are computed ahead by the workers.
+		auto computeRound = [&](SynthesisManager & manager, const RoundNo round_no, const ParamMask members, const size_t bound) {
+			const ParamNo first = split_manager.getParamNo(round_no);
+			return manager.checkRound(first, split_manager.getRoundSize(first), members, bound, user_options, property);
+		};
+		const bool share_bound = SynthesisManager::isBoundShareable(user_options, property);
+		unique_ptr<RoundSource> parallel;
+		auto startParallel = [&]() {
+			parallel.reset();
+			if (user_options.workers_count > 0)
+				parallel.reset(new ProcessManager(user_options.workers_count, product, split_manager.getRoundCount(), BFS_bound, share_bound, getMembers, computeRound));
+			else if (user_options.threads_count > 1)
+				parallel.reset(new ParallelManager(user_options.threads_count, product, split_manager.getRoundCount(), BFS_bound, share_bound, getMembers, computeRound));
+		};
+		startParallel();
 
 		// Do the computation for all the rounds
+		bool restart = false;
 		do {
+			restart = false;
 			output.outputRoundNo(split_manager.getRoundNo(), split_manager.getRoundCount());
-			if (!filter.isAllowed(kinetics, split_manager.getParamNo()))
-				continue;
+			const ParamNo first = split_manager.getParamNo();
+			RoundResults round = parallel ? parallel->getRound(split_manager.getRoundNo())
+				: synthesis_manager.checkRound(first, split_manager.getRoundSize(), getMembers(split_manager.getRoundNo()), BFS_bound, user_options, property);
 
-			vector<StateTransition> witness_trans;
-			double robustness_val = 0.;
-			size_t cost = INF;
+			for (const size_t member : crange(split_manager.getRoundSize())) {
+				if (((round.members >> member) & 1) == 0)
+					continue;
+				const ParamNo param_no = first + member;
+				RoundResults::Member & result = round.results[member];
 
-			// Call synthesis procedure based on the type of the property.
-			switch (product.getMyType()) {
-			case BA_finite:
-				cost = synthesis_manager.checkFinite(witness_trans, robustness_val, split_manager.getParamNo(), BFS_bound,
-					user_options.compute_wintess, user_options.compute_robustness, property.getMinAcc(), property.getMaxAcc());
-				break;
-			case BA_standard:
-				cost = synthesis_manager.checkFull(witness_trans, robustness_val, split_manager.getParamNo(), BFS_bound,
-					user_options.compute_wintess, user_options.compute_robustness);
-				break;
-			default:
-				throw runtime_error("Unsupported Buchi automaton type.");
+				// If the bound has dropped since the round was computed, only the parametrizations accepted under the old bound may still be accepted.
+				if (round.bound != BFS_bound && result.cost != INF)
+					synthesis_manager.resolveMember(result, param_no, BFS_bound, user_options, property);
+
+				// Parametrization was considered satisfying.
+				if ((result.cost != INF) ^ (user_options.produce_negative)) {
+					if (user_options.minimalize_cost) {
+						if (minimal.add(param_no, move(result))) {
+							BFS_bound = minimal.getBound();
+							// With counting, a parametrization may be both accepted and rejected under the lower bound, as fewer final states are reached within it.
+							if (property.isCountingUsed()) {
+								restart = true;
+								break;
+							}
+							if (parallel)
+								parallel->setBound(BFS_bound);
+						}
+						continue;
+					}
+					string witness_path = WitnessSearcher::getOutput(user_options.use_long_witnesses, product, result.trans);
+					output.outputRound(param_ID++, param_no, result.cost, result.robustness, witness_path);
+					param_count++;
+				}
 			}
 
-			// Parametrization was considered satisfying.
-			if ((cost != INF) ^ (user_options.produce_negative)) {
-				checkDepthBound(user_options.minimalize_cost, cost, split_manager, output, BFS_bound, param_count);
-				string witness_path = WitnessSearcher::getOutput(user_options.use_long_witnesses, product, witness_trans);
-				output.outputRound(param_ID++, split_manager.getParamNo(), cost, robustness_val, witness_path);
-				param_count++;
+			// All the rounds are checked again under the new bound.
+			if (restart) {
+				output_streamer.output(verbose_str, "Restarting the computation.");
+				minimal = MinimalBuffer(BFS_bound);
+				split_manager.setStartPositions();
+				startParallel();
 			}
-		} while (split_manager.increaseRound());
+		} while (restart || split_manager.increaseRound());
+
+		// Only the parametrizations with the lowest Cost have remained.
+		minimal.resolve(synthesis_manager, user_options, property);
+		for (const MinimalBuffer::MinimalParam & param : minimal.getParams()) {
+			string witness_path = WitnessSearcher::getOutput(user_options.use_long_witnesses, product, param.result.trans);
+			output.outputRound(param_ID++, param.param_no, param.result.cost, param.result.robustness, witness_path);
+			param_count++;
+		}
 
 		output_streamer.clear_line(verbose_str);
 		output.outputSummary(param_count, split_manager.getProcColorsCount());
+		if (parallel)
+			output_streamer.output(verbose_str, parallel->getLoadReport());
+		else if (user_options.use_memoization)
+			output_streamer.output(verbose_str, ResultCache::getHitReport(synthesis_manager.getCache().getHitCount(), synthesis_manager.getCache().getLookupCount()));
+		if (user_options.plan_parallel) {
+			const double elapsed = chrono::duration_cast<chrono::duration<double> >(chrono::steady_clock::now() - synthesis_start).count();
+			output_streamer.output(verbose_str, "Measured throughput: " + to_string(split_manager.getProcColorsCount() / max(elapsed, 1e-9)) + " parametrizations/s.");
+		}
 	}
 	catch (std::exception & e) {
 		output_streamer.output(error_str, string("Error occured while syntetizing the parametrizations: \"" + string(e.what()) + "\".\n Contact support for details."));
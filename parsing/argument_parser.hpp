@@ -41,6 +41,14 @@ class ArgumentParser {
       // Assert that process ID is in the range
       if (user_options.process_number > user_options.processes_count)
          throw runtime_error("Error while parsing the modifier --dist - ID of the process is bigger than number of processes");
+      if (user_options.processes_count == 0)
+         throw runtime_error("Error while parsing the modifier --dist - at least one process is required");
+
+      // The process 0 is the coordinator of the local workers, which compute the whole space together.
+      if (user_options.process_number == 0) {
+         user_options.workers_count = user_options.processes_count;
+         user_options.process_number = user_options.processes_count = 1;
+      }
 
       return 2;
    }
@@ -60,6 +68,82 @@ class ArgumentParser {
       return 1;
    }
 
+   /**
+    * Obtain the number of parametrizations checked in a single block.
+    */
+   int getBlock(UserOptions & user_options, vector<string>::const_iterator position, const vector<string>::const_iterator & end) {
+      try {
+         if (++position == end)
+            throw invalid_argument("Block size is missing");
+         user_options.block_size = lexical_cast<size_t>(*position);
+      } catch (bad_lexical_cast & e) {
+         throw invalid_argument("Error while parsing the modifier --block" + string(e.what()));
+      }
+
+      if (user_options.block_size == 0 || user_options.block_size > MASK_WIDTH)
+         throw invalid_argument("Error while parsing the modifier --block - the size must be between 1 and " + to_string(MASK_WIDTH));
+
+      return 1;
+   }
+
+   /**
+    * Obtain the number of parametrizations checked in a single window of intervals.
+    */
+   int getIntervals(UserOptions & user_options, vector<string>::const_iterator position, const vector<string>::const_iterator & end) {
+      try {
+         if (++position == end)
+            throw invalid_argument("Window size is missing");
+         user_options.interval_size = lexical_cast<size_t>(*position);
+      } catch (bad_lexical_cast & e) {
+         throw invalid_argument("Error while parsing the modifier --intervals" + string(e.what()));
+      }
+
+      if (user_options.interval_size == 0)
+         throw invalid_argument("Error while parsing the modifier --intervals - the size must be at least 1");
+
+      return 1;
+   }
+
+   /**
+    * Obtain the number of threads that conduct the synthesis, "auto" leaves the choice to the calibration.
+    */
+   int getThreads(UserOptions & user_options, vector<string>::const_iterator position, const vector<string>::const_iterator & end) {
+      try {
+         if (++position == end)
+            throw invalid_argument("Number of threads is missing");
+         if (position->compare("auto") == 0) {
+            user_options.plan_parallel = true;
+            return 1;
+         }
+         user_options.threads_count = lexical_cast<size_t>(*position);
+      } catch (bad_lexical_cast & e) {
+         throw invalid_argument("Error while parsing the modifier --threads" + string(e.what()));
+      }
+
+      if (user_options.threads_count == 0)
+         throw invalid_argument("Error while parsing the modifier --threads - at least one thread is required");
+
+      return 1;
+   }
+
+   /**
+    * Obtain the number of threads that share the BFS of a single parametrization.
+    */
+   int getBFSThreads(UserOptions & user_options, vector<string>::const_iterator position, const vector<string>::const_iterator & end) {
+      try {
+         if (++position == end)
+            throw invalid_argument("Number of threads is missing");
+         user_options.bfs_threads_count = lexical_cast<size_t>(*position);
+      } catch (bad_lexical_cast & e) {
+         throw invalid_argument("Error while parsing the modifier --bfs-threads" + string(e.what()));
+      }
+
+      if (user_options.bfs_threads_count == 0)
+         throw invalid_argument("Error while parsing the modifier --bfs-threads - at least one thread is required");
+
+      return 1;
+   }
+
    /**
     * @brief getFileName   stores path to a file based on its type in user options
     * @param filetype
@@ -125,6 +209,29 @@ class ArgumentParser {
          return getFileName(user_options, database, position, arguments.end());
       } else if (position->compare("--bound") == 0) {
          return getBound(user_options, position, arguments.end());
+      } else if (position->compare("--block") == 0) {
+         return getBlock(user_options, position, arguments.end());
+      } else if (position->compare("--intervals") == 0) {
+         return getIntervals(user_options, position, arguments.end());
+      } else if (position->compare("--symbolic") == 0) {
+         user_options.use_symbolic = true;
+         return 0;
+      } else if (position->compare("--incremental") == 0) {
+         user_options.use_incremental = true;
+         return 0;
+      } else if (position->compare("--gray") == 0) {
+         user_options.use_gray = true;
+         return 0;
+      } else if (position->compare("--memoize") == 0) {
+         user_options.use_memoization = true;
+         return 0;
+      } else if (position->compare("--backward") == 0) {
+         user_options.use_backward = true;
+         return 0;
+      } else if (position->compare("--threads") == 0) {
+         return getThreads(user_options, position, arguments.end());
+      } else if (position->compare("--bfs-threads") == 0) {
+         return getBFSThreads(user_options, position, arguments.end());
       } else {
          throw invalid_argument("Unknown modifier " + *position);
       }
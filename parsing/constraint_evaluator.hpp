@@ -0,0 +1,319 @@
+/*
+* Copyright (C) 2012-2013 - Adam Streck
+* This file is a part of the ParSyBoNe (Parameter Synthetizer for Boolean Networks) verification tool.
+* ParSyBoNe is a free software: you can redistribute it and/or modify it under the terms of the GNU General Public License version 3.
+* ParSyBoNe is released without any warranty. See the GNU General Public License for more details. <http://www.gnu.org/licenses/>.
+* For affiliations see <http://www.mi.fu-berlin.de/en/math/groups/dibimath> and <http://sybila.fi.muni.cz/>.
+*/
+
+#ifndef PARSYBONE_CONSTRAINT_EVALUATOR_INCLUDED
+#define PARSYBONE_CONSTRAINT_EVALUATOR_INCLUDED
+
+#include "../auxiliary/common_functions.hpp"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief A formula over the activity levels of the species, compiled into an expression tree that is evaluated directly for given levels.
+///
+/// Accepts the same formulae as the ConstraintParser, but instead of searching for their solutions it tests the states directly,
+/// which allows to list all the states of a space that satisfy the formula in a single scan of the space.
+/// The scan evaluates MASK_WIDTH consecutive states at once, each node of the tree yields a bitmask with a bit for each of the states.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class ConstraintEvaluator {
+	enum NodeType { constant, relation, negation, conjunction, disjunction };
+	enum Relation { eq, ne, le, lt, ge, gt };
+
+	/// Node of the tree, the children of a node are stored before it.
+	struct Node {
+		NodeType type;
+		bool value; ///< Value of a constant.
+		Relation rel; ///< Relation of the operands.
+		size_t left_specie; ///< Specie of the left operand, INF if the operand is a number.
+		int left_value; ///< Value of the left operand if it is a number.
+		size_t right_specie; ///< Specie of the right operand, INF if the operand is a number.
+		int right_value; ///< Value of the right operand if it is a number.
+		size_t first; ///< Position of the first child, the second one is right before the node.
+	};
+
+	vector<Node> nodes; ///< Nodes of the tree, the root is the last one.
+
+	/* Transform the string into an integer, if possible. Return true iff sucessful. */
+	static bool getNumber(const string & atom_part, int & value) {
+		try {
+			value = lexical_cast<int>(atom_part);
+		}
+		catch (...) {
+			return false;
+		}
+		return true;
+	}
+
+	/* Find the number of the specie with the given name. */
+	static size_t findName(const vector<string> & names, const string & specie_name) {
+		for (const size_t name_no : cscope(names))
+			if (specie_name.compare(names[name_no]) == 0)
+				return name_no;
+		throw runtime_error("Unrecognized variable name \"" + specie_name + "\".");
+	}
+
+	/* Split the formula by the specified operator (either | or &), only the symbols outside parenthesis are considered. */
+	static vector<string> splitByOperator(const bool is_or, const string & formula) {
+		vector<string> result;
+
+		int parity = 0;
+		size_t last_pos = 0;
+		for (const size_t pos : cscope(formula)) {
+			if (formula[pos] == '(')
+				parity++;
+			else if (formula[pos] == ')')
+				parity--;
+			if (parity < 0)
+				throw runtime_error("There is a right bracket without matching left bracket in the part \"" + formula + "\".");
+
+			if (parity == 0 && ((formula[pos] == '|' && is_or) || (formula[pos] == '&' && !is_or))) {
+				result.push_back(formula.substr(last_pos, pos - last_pos));
+				last_pos = pos + 1;
+			}
+		}
+
+		result.push_back(formula.substr(last_pos));
+
+		if (parity > 0)
+			throw runtime_error("There is a left bracket without matching right bracket in the part \"" + formula + "\".");
+
+		return result;
+	}
+
+	/* If the formula is enclosed in parenthesis, remove them. */
+	static void removeParenthesis(string & formula) {
+		if (formula.size() < 2 || *formula.begin() != '(' || *formula.rbegin() != ')')
+			return;
+		// Only the last parenthesis must be matching
+		size_t parity = 1;
+		for (const size_t pos : crange(static_cast<size_t>(1), formula.size() - 1)) {
+			if (formula[pos] == '(')
+				parity++;
+			else if (formula[pos] == ')')
+				parity--;
+			if (parity == 0)
+				return;
+		}
+
+		formula = formula.substr(1, formula.size() - 2);
+	}
+
+	size_t addNode(Node node) {
+		nodes.push_back(node);
+		return nodes.size() - 1;
+	}
+
+	/* Add a relation whose operands are matched to the species by name, at most one of them may be a number. */
+	size_t addRelation(const vector<string> & names, const string & left_side, const string & right_side, const Relation rel) {
+		Node node = { relation, false, rel, INF, 0, INF, 0, INF };
+		if (getNumber(left_side, node.left_value))
+			node.right_specie = findName(names, right_side);
+		else if (getNumber(right_side, node.right_value))
+			node.left_specie = findName(names, left_side);
+		else {
+			node.left_specie = findName(names, left_side);
+			node.right_specie = findName(names, right_side);
+		}
+		return addNode(node);
+	}
+
+	/* Convert the atomic expression to the relevant node. */
+	size_t addAtom(const vector<string> & names, const string & atom) {
+		if (atom.compare("tt") == 0)
+			return addNode({ constant, true, eq, INF, 0, INF, 0, INF });
+		else if (atom.compare("ff") == 0)
+			return addNode({ constant, false, eq, INF, 0, INF, 0, INF });
+		else if (atom.find("<=") != atom.npos)
+			return addRelation(names, atom.substr(0, atom.find("<=")), atom.substr(atom.find("<=") + 2), le);
+		else if (atom.find(">=") != atom.npos)
+			return addRelation(names, atom.substr(0, atom.find(">=")), atom.substr(atom.find(">=") + 2), ge);
+		else if (atom.find("!=") != atom.npos)
+			return addRelation(names, atom.substr(0, atom.find("!=")), atom.substr(atom.find("!=") + 2), ne);
+		else if (atom.find("=") != atom.npos)
+			return addRelation(names, atom.substr(0, atom.find("=")), atom.substr(atom.find("=") + 1), eq);
+		else if (atom.find("<") != atom.npos)
+			return addRelation(names, atom.substr(0, atom.find("<")), atom.substr(atom.find("<") + 1), lt);
+		else if (atom.find(">") != atom.npos)
+			return addRelation(names, atom.substr(0, atom.find(">")), atom.substr(atom.find(">") + 1), gt);
+		else
+			return addNode({ relation, false, eq, findName(names, atom), 0, INF, 1, INF });
+	}
+
+	/* Compile the formula into the nodes, return the position of its root. */
+	size_t compile(const vector<string> & names, string formula) {
+		// Remove outer parenthesis until you reach fixpoint.
+		string old_formula;
+		do {
+			old_formula = formula;
+			removeParenthesis(formula);
+		} while (old_formula.compare(formula) != 0);
+
+		const vector<string> div_by_or = splitByOperator(true, formula);
+		const vector<string> div_by_and = splitByOperator(false, formula);
+
+		if (div_by_or.size() == 1 && div_by_and.size() == 1) {
+			if (formula[0] != '!')
+				return addAtom(names, formula);
+			const size_t first = compile(names, formula.substr(1));
+			return addNode({ negation, false, eq, INF, 0, INF, 0, first });
+		}
+		else if (div_by_or.size() == 1 || div_by_and.size() == 1) {
+			const bool is_or = div_by_or.size() > 1;
+			const vector<string> & parts = is_or ? div_by_or : div_by_and;
+			size_t result = compile(names, parts[0]);
+			for (const size_t part_no : crange(static_cast<size_t>(1), parts.size())) {
+				const size_t first = result;
+				compile(names, parts[part_no]);
+				result = addNode({ is_or ? disjunction : conjunction, false, eq, INF, 0, INF, 0, first });
+			}
+			return result;
+		}
+		else {
+			throw runtime_error("Error when parsing the part \"" + formula + "\" Operators | and & are mixed, add parenthesis.");
+		}
+	}
+
+	bool evaluate(const size_t node_no, const Levels & levels) const {
+		const Node & node = nodes[node_no];
+		switch (node.type) {
+		case constant:
+			return node.value;
+		case negation:
+			return !evaluate(node.first, levels);
+		case conjunction:
+			return evaluate(node.first, levels) && evaluate(node_no - 1, levels);
+		case disjunction:
+			return evaluate(node.first, levels) || evaluate(node_no - 1, levels);
+		default:
+			break;
+		}
+
+		const int left = node.left_specie == INF ? node.left_value : static_cast<int>(levels[node.left_specie]);
+		const int right = node.right_specie == INF ? node.right_value : static_cast<int>(levels[node.right_specie]);
+		switch (node.rel) {
+		case eq:
+			return left == right;
+		case ne:
+			return left != right;
+		case le:
+			return left <= right;
+		case lt:
+			return left < right;
+		case ge:
+			return left >= right;
+		default:
+			return left > right;
+		}
+	}
+
+	/* Compare the operands in each lane, a number is the same in all the lanes. */
+	template <class Compare>
+	static ParamMask compareLanes(const int * left, const size_t left_step, const int * right, const size_t right_step, Compare compare) {
+		ParamMask result = 0;
+		for (size_t lane = 0; lane < MASK_WIDTH; lane++)
+			result |= static_cast<ParamMask>(compare(left[lane * left_step], right[lane * right_step])) << lane;
+		return result;
+	}
+
+	ParamMask compareLanes(const Node & node, const vector<int> & block) const {
+		const int * left = node.left_specie == INF ? &node.left_value : &block[node.left_specie * MASK_WIDTH];
+		const size_t left_step = node.left_specie == INF ? 0 : 1;
+		const int * right = node.right_specie == INF ? &node.right_value : &block[node.right_specie * MASK_WIDTH];
+		const size_t right_step = node.right_specie == INF ? 0 : 1;
+		switch (node.rel) {
+		case eq:
+			return compareLanes(left, left_step, right, right_step, equal_to<int>());
+		case ne:
+			return compareLanes(left, left_step, right, right_step, not_equal_to<int>());
+		case le:
+			return compareLanes(left, left_step, right, right_step, less_equal<int>());
+		case lt:
+			return compareLanes(left, left_step, right, right_step, less<int>());
+		case ge:
+			return compareLanes(left, left_step, right, right_step, greater_equal<int>());
+		default:
+			return compareLanes(left, left_step, right, right_step, greater<int>());
+		}
+	}
+
+	/**
+	 * Evaluate the formula for a block of MASK_WIDTH states at once, the nodes are evaluated in their order so that the children are always ready.
+	 * @param block	level of the specie s in the state of the lane l is at block[s * MASK_WIDTH + l]
+	 * @param values	buffer for the values of the nodes, a bit for each lane
+	 * @return	the lanes whose states satisfy the formula
+	 */
+	ParamMask evaluateBlock(const vector<int> & block, vector<ParamMask> & values) const {
+		for (const size_t node_no : cscope(nodes)) {
+			const Node & node = nodes[node_no];
+			switch (node.type) {
+			case constant:
+				values[node_no] = node.value ? ~static_cast<ParamMask>(0) : 0;
+				break;
+			case relation:
+				values[node_no] = compareLanes(node, block);
+				break;
+			case negation:
+				values[node_no] = ~values[node.first];
+				break;
+			case conjunction:
+				values[node_no] = values[node.first] & values[node_no - 1];
+				break;
+			case disjunction:
+				values[node_no] = values[node.first] | values[node_no - 1];
+				break;
+			}
+		}
+		return values.back();
+	}
+
+public:
+	ConstraintEvaluator() = default;
+
+	/**
+	 * @param names	names of the species, in the order of their levels
+	 * @param formula	formula in the syntax of the ConstraintParser
+	 */
+	ConstraintEvaluator(const vector<string> & names, string formula) {
+		formula.erase(remove_if(formula.begin(), formula.end(), (int(*)(int))isspace), formula.end());
+		compile(names, formula);
+	}
+
+	/**
+	 * @return true iff the levels satisfy the formula
+	 */
+	inline bool evaluate(const Levels & levels) const {
+		return evaluate(nodes.size() - 1, levels);
+	}
+
+	/**
+	 * Mark the states of the space [mins, maxes] that satisfy the formula. The states are numbered in the mixed-radix order,
+	 * the first specie changing the fastest, the same way as the states of the UnparametrizedStructure.
+	 * @param[out] marked	marked[ID] is set to true for each state ID that satisfies the formula, the rest is left as it is
+	 */
+	void markStates(const Levels & mins, const Levels & maxes, vector<bool> & marked) const {
+		vector<int> block(mins.size() * MASK_WIDTH);
+		vector<ParamMask> values(nodes.size());
+		Levels levels(mins);
+		StateID block_start = 0;
+		for (bool valid = true; valid;) {
+			// Spread the states of the block into the lanes.
+			size_t lanes_count = 0;
+			for (; lanes_count < MASK_WIDTH && valid; lanes_count++) {
+				for (const size_t specie : cscope(levels))
+					block[specie * MASK_WIDTH + lanes_count] = levels[specie];
+				valid = iterate(maxes, mins, levels);
+			}
+
+			const ParamMask satisfied = evaluateBlock(block, values);
+			for (const size_t lane : crange(lanes_count))
+				if ((satisfied >> lane) & 1)
+					marked[block_start + lane] = true;
+			block_start += lanes_count;
+		}
+	}
+};
+
+#endif // PARSYBONE_CONSTRAINT_EVALUATOR_INCLUDED
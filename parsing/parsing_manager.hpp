@@ -15,6 +15,28 @@
 #include "argument_parser.hpp"
 
 namespace ParsingManager {
+   /**
+    * @brief checkOptions throw if the options contain switches or modifiers that can not be used together
+    */
+   void checkOptions(const UserOptions & user_options) {
+      if (user_options.produce_negative & (user_options.analysis() | user_options.minimalize_cost | (user_options.bound_size != INF)))
+         throw runtime_error("The switch -n can not be used together with -m, -W, -w, -r, --bound as it produces only parametrizations that do not allow accepting by the automaton.");
+      if (user_options.workers_count > 0 && user_options.threads_count > 1)
+         throw runtime_error("The modifier --threads can not be used together with --dist 0 N as the computation is already divided between the worker processes.");
+      if (user_options.plan_parallel && (user_options.workers_count > 0 || user_options.bfs_threads_count > 1))
+         throw runtime_error("The modifier --threads auto can not be used together with --bfs-threads or --dist 0 N.");
+      if (user_options.bfs_threads_count > 1 && (user_options.workers_count > 0 || user_options.threads_count > 1))
+         throw runtime_error("The modifier --bfs-threads can not be used together with --threads or --dist 0 N as the parametrizations are already checked in parallel.");
+      if (user_options.use_symbolic && (user_options.analysis() || !user_options.filter_databases.empty() || user_options.processes_count > 1 || user_options.workers_count > 0
+         || user_options.threads_count > 1 || user_options.plan_parallel || user_options.bfs_threads_count > 1 || user_options.block_size > 1 || user_options.interval_size > 0))
+         throw runtime_error("The modifier --symbolic can be used only together with -m, -n, --bound and the outputs as the parametrizations are not checked one by one.");
+      if (user_options.interval_size > 0 && (user_options.processes_count > 1 || user_options.workers_count > 0 || user_options.threads_count > 1 || user_options.plan_parallel))
+         throw runtime_error("The modifier --intervals can not be used together with --threads or --dist as a window of intervals spans the rounds of the other threads or processes.");
+      if (user_options.use_gray && (user_options.block_size > 1 || user_options.interval_size > 0 || user_options.plan_parallel || user_options.use_symbolic
+         || !user_options.filter_databases.empty()))
+         throw runtime_error("The modifier --gray can not be used together with --block, --intervals, --threads auto, --symbolic or a filtering database as they expect the parametrizations in the ascending order.");
+   }
+
    /**
     * @brief parseOptions parse user arguments
     */
@@ -29,6 +51,7 @@ namespace ParsingManager {
       ArgumentParser parser;
       user_options = parser.parseArguments(arguments);
       user_options.addDefaultFiles();
+      checkOptions(user_options);
 
       if (user_options.use_textfile) {
          output_streamer.createStreamFile(results_str, user_options.datatext_file);
@@ -10,6 +10,7 @@
 #define CHECKER_SETTING_HPP
 
 #include "../construction/product_structure.hpp"
+#include "param_set.hpp"
 
 class CheckerSettings {
 public:
@@ -17,16 +18,28 @@ public:
    vector<StateID> final_states;
    bool minimize_cost;
    ParamNo param_no;
+   ParamMask members; ///< For a block check, i-th bit set iff the parametrization param_no + i is checked.
+   ParamSet params; ///< For an interval check, the parametrizations that are checked.
    size_t bfs_bound;
+   const atomic<size_t> * shared_bound; ///< If set, a bound on the Cost shared with the other workers, which may drop during the check.
    bool mark_initals;
    size_t minimal_count;
+   bool guide_backward; ///< For a single parametrization, should the BFS enter only the states from which a final state can be reached within the bound?
 
-   CheckerSettings() :  minimize_cost(false), param_no(INF), bfs_bound(INF), mark_initals(false), minimal_count(1) { }
+   CheckerSettings() :  minimize_cost(false), param_no(INF), members(0), bfs_bound(INF), shared_bound(nullptr), mark_initals(false), minimal_count(1), guide_backward(false) { }
 
    inline const ParamNo & getParamNo() const {
       return param_no;
    }
 
+   inline ParamMask getMembers() const {
+      return members;
+   }
+
+   inline const ParamSet & getParams() const {
+      return params;
+   }
+
    inline bool mimizeCost() const {
       return minimize_cost;
    }
@@ -60,7 +73,7 @@ public:
    }
 
    inline size_t getBound() const {
-      return bfs_bound;
+      return shared_bound ? min(bfs_bound, shared_bound->load(memory_order_relaxed)) : bfs_bound;
    }
 
    inline bool markInitials() const {
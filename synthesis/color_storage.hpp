@@ -12,12 +12,16 @@
 #include "../auxiliary/common_functions.hpp"
 
 #include "../auxiliary/data_types.hpp"
+#include "../auxiliary/stamped_vector.hpp"
+#include "param_set.hpp"
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// \brief An auxiliary class to the ProductStructure and stores colors and possibly predecessors for individual states of the product during the computation.
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 class ColorStorage {	
-   vector<bool> states; ///< Vector of states that correspond to those of Product Structure and store coloring data.
+   StampedVector<char> states; ///< States that correspond to those of Product Structure, a state is colored if it has been set since the last reset.
+   StampedVector<ParamMask> masks; ///< Parametrizations of the current block that have reached the state, allocated only if blocks are used.
+   StampedVector<ParamSet> sets; ///< Parametrizations of the current interval check that have reached the state, allocated only if intervals are used.
 
 public:
 	/**
@@ -27,32 +31,16 @@ public:
 	 */
    ColorStorage(const ProductStructure & product) {
       // Create states
-      states.resize(product.getStateCount(), false);
+      states.resize(product.getStateCount());
 	}
 
 	ColorStorage() = default; ///< Empty constructor for an empty storage.
 
-   /**
-    * Function adds values from specified source without explicitly copying them, only through bitwise or (storages must be equal).
-    */
-   void addFrom(const ColorStorage & other) {
-
-      auto m_state_it = states.begin();
-      auto o_state_it = other.states.begin();
-
-      while (m_state_it != states.end()) {
-         // Copy from paramset
-         *m_state_it = (*m_state_it == true) || (*o_state_it == true);
-
-         m_state_it++; o_state_it++;
-      }
-   }
-
 	/**
-	 * Sets all values for all the states to zero. Allocated memory remains.
+	 * Sets all values for all the states to zero. Allocated memory remains and only the states colored since the last reset are cleared (lazily).
 	 */ 
 	void reset() {
-      states.assign(states.size(),false);
+      states.reset();
 	}
 
 	/**
@@ -62,12 +50,8 @@ public:
     * @return  true if there was an actuall update
 	 */
    inline bool update(const StateID & col) {
-		// If nothing is new return false
-      if (states[col])
-			return false;
-		// Add new parameters and return true
-      states[col] = true;
-		return true;
+		// Returns false if the state has already been colored
+      return states.touch(col);
 	}
 
 	/**
@@ -75,10 +59,7 @@ public:
     * @return  true if there would be an update
 	 */
    inline bool isFound(const StateID & col) {
-      if (states[col])
-			return false;
-		else
-			return true;
+      return !states.isSet(col);
 	}
 
    /**
@@ -86,8 +67,68 @@ public:
     * @return  parameters assigned to the state
 	 */
     inline bool getColor(const StateID ID) const {
-        return states[ID];
+        return states.isSet(ID);
 	}
+
+   /**
+    * Sets masks of all the states to zero, allocates them if it has not been done yet.
+    */
+   void resetMasks() {
+      if (masks.size() != states.size())
+         masks.resize(states.size());
+      else
+         masks.reset();
+   }
+
+   /**
+    * Add parametrizations of the block to the state.
+    * @param ID	index of the state to fill
+    * @param mask	parametrizations to add
+    * @return  parametrizations that were not present before
+    */
+   inline ParamMask updateMask(const StateID ID, const ParamMask mask) {
+      const ParamMask fresh = mask & ~masks.get(ID);
+      masks[ID] |= fresh;
+      return fresh;
+   }
+
+   /**
+    * @param ID	index of the state to ask for parameters
+    * @return  parametrizations of the block assigned to the state
+    */
+   inline ParamMask getMask(const StateID ID) const {
+      return masks.get(ID);
+   }
+
+   /**
+    * Sets sets of all the states to empty, allocates them if it has not been done yet.
+    */
+   void resetSets() {
+      if (sets.size() != states.size())
+         sets.resize(states.size());
+      else
+         sets.reset();
+   }
+
+   /**
+    * Add parametrizations of the interval check to the state.
+    * @return  parametrizations that were not present before
+    */
+   ParamSet updateSet(const StateID ID, const ParamSet & params) {
+      ParamSet fresh = ParamSet::subtract(params, sets.get(ID));
+      if (!fresh.empty()) {
+         ParamSet present = ParamSet::unite(sets.get(ID), fresh);
+         swap(sets[ID], present);
+      }
+      return fresh;
+   }
+
+   /**
+    * @return  parametrizations of the interval check assigned to the state
+    */
+   inline const ParamSet & getSet(const StateID ID) const {
+      return sets.get(ID);
+   }
 };
 
 #endif // PARSYBONE_COLOR_STORAGE_INCLUDED
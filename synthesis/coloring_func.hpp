@@ -10,38 +10,157 @@
 #define COLORING_FUNC_HPP
 
 #include "../construction/product_structure.hpp"
+#include "param_set.hpp"
 
 namespace ColoringFunc {
    /**
-    * @return true if this transition is open for given parametrization
+    * @return target value of the context under given parametrization
     */
-   bool isOpen(const ParamNo param_no, const TransConst & trans_cost) {
-      const size_t value_num = (param_no / trans_cost.step_size) % trans_cost.targets.size();
+   inline ActLevel getTarget(const ParamNo param_no, const TransContext & context) {
+      return context.targets[(param_no / context.step_size) % context.targets.size()];
+   }
+
+   /**
+    * Decode the parametrization into a table of target values of all the contexts, so that the openness of a transition can be tested without division.
+    * @param[out] values	values[i] is the target of the i-th context
+    */
+   void decode(const ParamNo param_no, const vector<TransContext> & contexts, Levels & values) {
+      values.resize(contexts.size());
+      for (const size_t context_no : cscope(contexts))
+         values[context_no] = getTarget(param_no, contexts[context_no]);
+   }
 
+   /**
+    * @param values	target values of the contexts, as obtained by decode
+    * @return true if this transition is open for the decoded parametrization
+    */
+   inline bool isOpen(const Levels & values, const TransConst & trans_cost) {
       if (trans_cost.req_dir)
-         return trans_cost.targets[value_num] > trans_cost.comp_value;
+         return values[trans_cost.context] > trans_cost.comp_value;
       else
-         return trans_cost.targets[value_num] < trans_cost.comp_value;
+         return values[trans_cost.context] < trans_cost.comp_value;
    }
 
    /**
-    * @return vector of reachable targets from ID for this parametrization
+    * Computes openness for a contiguous range of parametrizations without any division in the loop.
+    * The value of the specie changes only every step_size parametrizations, therefore the range is split into runs of the same value
+    * and each run is filled in the mask at once.
+    * @param first	number of the first parametrization of the range
+    * @param count	number of the parametrizations in the range, at most MASK_WIDTH
+    * @return mask of the parametrizations from the range for which the transition is open
     */
-   template <class State>
-   vector<StateID> broadcastParameters(const ParamNo param_no, const TSInterface<State> & ts, const StateID ID) {
-      // To store parameters that passed the transition but were not yet added to the target
-      vector<StateID> param_updates;
+   ParamMask openMask(const ParamNo first, const TransContext & context, const TransConst & trans_const, const size_t count = MASK_WIDTH) {
+      ParamMask mask = 0;
+      const size_t targets_count = context.targets.size();
 
-      // Cycle through all the transition
-      for (size_t trans_num = 0; trans_num < ts.getTransitionCount(ID); trans_num++) {
-         StateID target_ID = ts.getTargetID(ID, trans_num);
+      // Position within the first run.
+      size_t value_num = static_cast<size_t>((first / context.step_size) % targets_count);
+      ParamNo run_length = context.step_size - first % context.step_size;
 
-         // From an update strip all the parameters that can not pass through the transition - color intersection on the transition
-         if (ColoringFunc::isOpen(param_no, ts.getTransitionConst(ID, trans_num)))
-            param_updates.push_back(target_ID);
+      for (size_t position = 0; position < count; ) {
+         const size_t length = static_cast<size_t>(min(run_length, static_cast<ParamNo>(count - position)));
+         const ActLevel target = context.targets[value_num];
+         if (trans_const.req_dir ? target > trans_const.comp_value : target < trans_const.comp_value)
+            mask |= (length == MASK_WIDTH ? ~static_cast<ParamMask>(0) : ((static_cast<ParamMask>(1) << length) - 1)) << position;
+
+         position += length;
+         run_length = context.step_size;
+         if (++value_num == targets_count)
+            value_num = 0;
       }
 
-      return param_updates;
+      return mask;
+   }
+
+   /**
+    * @param needed	parametrizations that are of interest, the computation ends once all of them are known to leave
+    * @return mask of the parametrizations from the block starting at first for which some transition leads out of ID
+    */
+   template <class Graph>
+   ParamMask leavingMask(const ParamNo first, const vector<TransContext> & contexts, const Graph & ts, const StateID ID, const ParamMask needed) {
+      ParamMask mask = 0;
+
+      for (size_t trans_num = 0; trans_num < ts.getTransitionCount(ID) && (mask & needed) != needed; trans_num++) {
+         const TransConst & trans_const = ts.getTransitionConst(ID, trans_num);
+         mask |= openMask(first, contexts[trans_const.context], trans_const);
+      }
+
+      return mask;
+   }
+
+   /**
+    * Interval version of the openMask - the words of the bitmap on which the open mask does not change are covered at once.
+    * That holds for all the words if the period of the context divides MASK_WIDTH and for the words within a single run of step_size parametrizations.
+    * @return parametrizations from the set for which the transition is open
+    */
+   ParamSet openSet(const ParamSet & params, const TransContext & context, const TransConst & trans_const) {
+      ParamSet open;
+      const ParamNo period = context.step_size * context.targets.size();
+
+      for (const ParamSet::Interval & interval : params.getIntervals()) {
+         for (ParamNo word = interval.first; word < interval.last; ) {
+            const ParamNo first = word * MASK_WIDTH;
+            ParamNo next = word + 1;
+            if (MASK_WIDTH % period == 0)
+               next = interval.last;
+            else if (first % context.step_size + MASK_WIDTH <= context.step_size)
+               next = min(interval.last, (first / context.step_size + 1) * context.step_size / MASK_WIDTH);
+
+            open.append(word, next, interval.mask & openMask(first, context, trans_const));
+            word = next;
+         }
+      }
+
+      return open;
+   }
+
+   /**
+    * @return parametrizations from the set for which some transition leads out of ID
+    */
+   template <class Graph>
+   ParamSet leavingSet(const ParamSet & params, const vector<TransContext> & contexts, const Graph & ts, const StateID ID) {
+      ParamSet leaving;
+
+      for (size_t trans_num = 0; trans_num < ts.getTransitionCount(ID) && !(leaving == params); trans_num++) {
+         const TransConst & trans_const = ts.getTransitionConst(ID, trans_num);
+         leaving = ParamSet::unite(leaving, openSet(params, contexts[trans_const.context], trans_const));
+      }
+
+      return leaving;
+   }
+
+   /**
+    * @param values	target values of the contexts for the current parametrization, as obtained by decode
+    * @return true if no transition leads out of ID for this parametrization
+    */
+   template <class Graph>
+   bool isStable(const Levels & values, const Graph & ts, const StateID ID) {
+      for (size_t trans_num = 0; trans_num < ts.getTransitionCount(ID); trans_num++)
+         if (ColoringFunc::isOpen(values, ts.getTransitionConst(ID, trans_num)))
+            return false;
+
+      return true;
+   }
+
+   /**
+    * Call visit(target_ID) for each target reachable from ID for this parametrization, nothing is allocated.
+    * @param values	target values of the contexts for the current parametrization, as obtained by decode
+    * @return number of the targets visited
+    */
+   template <class Graph, class Visitor>
+   size_t forEachSuccessor(const Levels & values, const Graph & ts, const StateID ID, Visitor && visit) {
+      size_t count = 0;
+
+      // Cycle through all the transition
+      ts.forEachTransition(ID, [&](const StateID target_ID, const TransConst & trans_const) {
+         // From an update strip all the parameters that can not pass through the transition - color intersection on the transition
+         if (ColoringFunc::isOpen(values, trans_const)) {
+            visit(target_ID);
+            count++;
+         }
+      });
+
+      return count;
    }
 }
 
@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2012-2013 - Adam Streck
+ * This file is a part of the ParSyBoNe (Parameter Synthetizer for Boolean Networks) verification tool.
+ * ParSyBoNe is a free software: you can redistribute it and/or modify it under the terms of the GNU General Public License version 3.
+ * ParSyBoNe is released without any warranty. See the GNU General Public License for more details. <http://www.gnu.org/licenses/>.
+ * For affiliations see <http://www.mi.fu-berlin.de/en/math/groups/dibimath> and <http://sybila.fi.muni.cz/>.
+ */
+
+#ifndef PARSYBONE_DECISION_DIAGRAM_INCLUDED
+#define PARSYBONE_DECISION_DIAGRAM_INCLUDED
+
+#include "../auxiliary/common_functions.hpp"
+
+#include <unordered_map>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief A reduced ordered multi-valued decision diagram over numbers composed of digits, used to hold sets of parametrizations.
+///
+/// Each level of the diagram decides a single digit of the number, the number is the sum of the digits multiplied by the weights of their levels.
+/// The nodes are shared and never freed, a node whose children are all the same is skipped, so that a missing level means any value of the digit.
+/// The results of the operations are cached for the lifetime of the diagram.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class DecisionDiagram {
+public:
+	typedef size_t Node; ///< Index of a node of the diagram.
+	/// The terminals.
+	enum : Node {
+		EMPTY = 0, ///< Terminal of the empty set.
+		FULL = 1 ///< Terminal of the set of all the numbers.
+	};
+
+private:
+	enum Operation { conjunction, disjunction, difference };
+
+	/// A node deciding the digit of its level, the children of the values are stored one after another in the pool.
+	struct Inner {
+		size_t level;
+		size_t children;
+	};
+
+	struct KeyHash {
+		size_t operator()(const vector<Node> & key) const {
+			size_t hash = key.size();
+			for (const Node node : key)
+				hash ^= node + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+			return hash;
+		}
+	};
+
+	vector<ParamNo> domains; ///< Number of the values of the digit of each level.
+	vector<ParamNo> weights; ///< Weight of the digit of each level.
+	vector<Inner> nodes; ///< All the nodes, the terminals included.
+	vector<Node> pool; ///< Children of the inner nodes.
+	unordered_map<vector<Node>, Node, KeyHash> unique; ///< Node for the level and the children, so that equal nodes are never created twice.
+	unordered_map<vector<Node>, Node, KeyHash> computed; ///< Result of an operation on two nodes.
+
+	inline size_t getLevel(const Node node) const {
+		return nodes[node].level;
+	}
+
+	/**
+	 * @return the node that decides the level with the given value, the node itself if it does not decide it
+	 */
+	inline Node getChild(const Node node, const size_t level, const size_t value) const {
+		return getLevel(node) == level ? pool[nodes[node].children + value] : node;
+	}
+
+	/**
+	 * @return the node of the level with the given children, skipped if all of them are the same
+	 */
+	Node makeNode(const size_t level, const vector<Node> & children) {
+		if (all_of(children.begin(), children.end(), [&children](const Node child) { return child == children.front(); }))
+			return children.front();
+
+		vector<Node> key(1, level);
+		key.insert(key.end(), children.begin(), children.end());
+		auto known = unique.find(key);
+		if (known != unique.end())
+			return known->second;
+
+		const Node node = nodes.size();
+		nodes.push_back({ level, pool.size() });
+		pool.insert(pool.end(), children.begin(), children.end());
+		unique.insert({ move(key), node });
+		return node;
+	}
+
+	Node apply(const Operation operation, Node first, Node second) {
+		switch (operation) {
+		case conjunction:
+			if (first == EMPTY || second == EMPTY)
+				return EMPTY;
+			if (first == FULL || first == second)
+				return second;
+			if (second == FULL)
+				return first;
+			break;
+		case disjunction:
+			if (first == FULL || second == FULL)
+				return FULL;
+			if (first == EMPTY || first == second)
+				return second;
+			if (second == EMPTY)
+				return first;
+			break;
+		case difference:
+			if (first == EMPTY || second == FULL || first == second)
+				return EMPTY;
+			if (second == EMPTY)
+				return first;
+			break;
+		}
+		if (operation != difference && first > second)
+			swap(first, second);
+
+		vector<Node> key = { static_cast<Node>(operation), first, second };
+		auto known = computed.find(key);
+		if (known != computed.end())
+			return known->second;
+
+		const size_t level = min(getLevel(first), getLevel(second));
+		vector<Node> children(static_cast<size_t>(domains[level]));
+		for (const size_t value : cscope(children))
+			children[value] = apply(operation, getChild(first, level, value), getChild(second, level, value));
+		const Node result = makeNode(level, children);
+		computed.insert({ move(key), result });
+		return result;
+	}
+
+	/* Number of the values of the levels [level, levels count) that lead to FULL. */
+	ParamNo count(const Node node, const size_t level, map<Node, ParamNo> & counted) const {
+		if (node == EMPTY)
+			return 0;
+		// The skipped levels allow any value.
+		ParamNo skipped = 1;
+		for (const size_t skipped_level : crange(level, min(getLevel(node), domains.size())))
+			skipped *= domains[skipped_level];
+		if (node == FULL)
+			return skipped;
+
+		auto known = counted.find(node);
+		if (known == counted.end()) {
+			ParamNo sum = 0;
+			for (const size_t value : crange(static_cast<size_t>(domains[getLevel(node)])))
+				sum += count(pool[nodes[node].children + value], getLevel(node) + 1, counted);
+			known = counted.insert({ node, sum }).first;
+		}
+		return skipped * known->second;
+	}
+
+	template <class Visitor>
+	void enumerate(const Node node, const size_t level, const ParamNo number, Visitor & visit) const {
+		if (node == EMPTY)
+			return;
+		if (level == domains.size()) {
+			visit(number);
+			return;
+		}
+		for (const size_t value : crange(static_cast<size_t>(domains[level])))
+			enumerate(getChild(node, level, value), level + 1, number + value * weights[level], visit);
+	}
+
+public:
+	/**
+	 * @param _domains	number of the values of the digit of each level, the first level is at the top of the diagram
+	 * @param _weights	weight of the digit of each level, the numbers are enumerated in the ascending order if the weights descend
+	 */
+	DecisionDiagram(const vector<ParamNo> & _domains, const vector<ParamNo> & _weights) : domains(_domains), weights(_weights) {
+		// The terminals are below all the levels.
+		nodes.push_back({ domains.size(), 0 });
+		nodes.push_back({ domains.size(), 0 });
+	}
+
+	/**
+	 * @return numbers whose digit of the level has one of the values marked
+	 */
+	Node makeLiteral(const size_t level, const vector<bool> & values) {
+		vector<Node> children(values.size());
+		for (const size_t value : cscope(values))
+			children[value] = values[value] ? FULL : EMPTY;
+		return makeNode(level, children);
+	}
+
+	inline Node conjoin(const Node first, const Node second) {
+		return apply(conjunction, first, second);
+	}
+
+	inline Node disjoin(const Node first, const Node second) {
+		return apply(disjunction, first, second);
+	}
+
+	inline Node subtract(const Node first, const Node second) {
+		return apply(difference, first, second);
+	}
+
+	/**
+	 * @return true if the number is in the set
+	 */
+	bool contains(Node node, const ParamNo number) const {
+		while (node != EMPTY && node != FULL) {
+			const size_t level = getLevel(node);
+			node = pool[nodes[node].children + static_cast<size_t>((number / weights[level]) % domains[level])];
+		}
+		return node == FULL;
+	}
+
+	/**
+	 * @return number of the numbers in the set
+	 */
+	ParamNo count(const Node node) const {
+		map<Node, ParamNo> counted;
+		return count(node, 0, counted);
+	}
+
+	/**
+	 * Call visit(number) for each number of the set, in the ascending order if the weights descend.
+	 */
+	template <class Visitor>
+	void forEach(const Node node, Visitor && visit) const {
+		enumerate(node, 0, 0, visit);
+	}
+
+	/**
+	 * @return number of the nodes created so far, the terminals included
+	 */
+	inline size_t getNodeCount() const {
+		return nodes.size();
+	}
+};
+
+#endif // PARSYBONE_DECISION_DIAGRAM_INCLUDED
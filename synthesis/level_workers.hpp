@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2012-2013 - Adam Streck
+ * This file is a part of the ParSyBoNe (Parameter Synthetizer for Boolean Networks) verification tool.
+ * ParSyBoNe is a free software: you can redistribute it and/or modify it under the terms of the GNU General Public License version 3.
+ * ParSyBoNe is released without any warranty. See the GNU General Public License for more details. <http://www.gnu.org/licenses/>.
+ * For affiliations see <http://www.mi.fu-berlin.de/en/math/groups/dibimath> and <http://sybila.fi.muni.cz/>.
+ */
+
+#ifndef PARSYBONE_LEVEL_WORKERS_INCLUDED
+#define PARSYBONE_LEVEL_WORKERS_INCLUDED
+
+#include "../auxiliary/common_functions.hpp"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief A fixed group of threads that conduct a single loop together, used to split a level of the BFS.
+///
+/// The threads are started once and sleep in between the loops. The items of a loop are taken in ranges of a given size from a shared counter,
+/// the calling thread takes part in the loop as the worker 0 and the call returns only after all the items have been processed.
+/// A loop that does not have more than a single range is conducted by the calling thread alone, so that the small levels do not pay for the synchronization.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class LevelWorkers {
+public:
+	/// Processes the items [begin, end) by the given worker.
+	typedef function<void(const size_t worker, const size_t begin, const size_t end)> RangeFunc;
+
+private:
+	const size_t workers_count;
+	vector<thread> threads;
+
+	mutex loop_mutex; ///< Guards all the data below, except for the counter.
+	condition_variable start_cond;
+	condition_variable done_cond;
+	size_t generation; ///< Number of the current loop, a change wakes the threads.
+	size_t running; ///< Threads that have not finished the current loop yet.
+	bool stopped;
+	const RangeFunc * range_func;
+	size_t items_count;
+	size_t range_size;
+	atomic<size_t> next_item; ///< The first item that has not been taken yet.
+	exception_ptr failure; ///< The first exception thrown in the current loop.
+
+	/* Take the ranges until there are none, a failure empties the loop for the others. */
+	void work(const size_t worker) {
+		try {
+			size_t begin;
+			while ((begin = next_item.fetch_add(range_size)) < items_count)
+				(*range_func)(worker, begin, min(begin + range_size, items_count));
+		} catch (...) {
+			next_item = items_count;
+			lock_guard<mutex> lock(loop_mutex);
+			if (!failure)
+				failure = current_exception();
+		}
+	}
+
+	/* Body of a thread - conduct each loop and report its end. */
+	void serve(const size_t worker) {
+		size_t served = 0;
+		while (true) {
+			{
+				unique_lock<mutex> lock(loop_mutex);
+				start_cond.wait(lock, [this, served]() { return stopped || generation != served; });
+				if (stopped)
+					return;
+				served = generation;
+			}
+			work(worker);
+			lock_guard<mutex> lock(loop_mutex);
+			if (--running == 0)
+				done_cond.notify_one();
+		}
+	}
+
+public:
+	/**
+	 * Start the threads, there are workers_count - 1 of them as the caller of forEach takes part as well.
+	 */
+	LevelWorkers(const size_t _workers_count) : workers_count(_workers_count), generation(0), running(0), stopped(false), range_func(nullptr),
+		items_count(0), range_size(1), next_item(0) {
+		for (const size_t worker : crange(static_cast<size_t>(1), workers_count))
+			threads.emplace_back(&LevelWorkers::serve, this, worker);
+	}
+
+	LevelWorkers(const LevelWorkers &) = delete;
+	LevelWorkers& operator=(const LevelWorkers &) = delete;
+
+	~LevelWorkers() {
+		{
+			lock_guard<mutex> lock(loop_mutex);
+			stopped = true;
+		}
+		start_cond.notify_all();
+		for (thread & worker : threads)
+			worker.join();
+	}
+
+	inline size_t getCount() const {
+		return workers_count;
+	}
+
+	/**
+	 * Call func on all the items [0, count) split into ranges of range_size items, the ranges are processed in no particular order.
+	 */
+	void forEach(const size_t count, const size_t _range_size, const RangeFunc & func) {
+		if (count <= _range_size || workers_count == 1) {
+			if (count > 0)
+				func(0, 0, count);
+			return;
+		}
+
+		{
+			lock_guard<mutex> lock(loop_mutex);
+			range_func = &func;
+			items_count = count;
+			range_size = _range_size;
+			next_item = 0;
+			failure = nullptr;
+			running = workers_count - 1;
+			generation++;
+		}
+		start_cond.notify_all();
+		work(0);
+
+		unique_lock<mutex> lock(loop_mutex);
+		done_cond.wait(lock, [this]() { return running == 0; });
+		if (failure)
+			rethrow_exception(failure);
+	}
+};
+
+#endif // PARSYBONE_LEVEL_WORKERS_INCLUDED
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2012-2013 - Adam Streck
+ * This file is a part of the ParSyBoNe (Parameter Synthetizer for Boolean Networks) verification tool.
+ * ParSyBoNe is a free software: you can redistribute it and/or modify it under the terms of the GNU General Public License version 3.
+ * ParSyBoNe is released without any warranty. See the GNU General Public License for more details. <http://www.gnu.org/licenses/>.
+ * For affiliations see <http://www.mi.fu-berlin.de/en/math/groups/dibimath> and <http://sybila.fi.muni.cz/>.
+ */
+
+#ifndef PARSYBONE_MINIMAL_BUFFER_INCLUDED
+#define PARSYBONE_MINIMAL_BUFFER_INCLUDED
+
+#include "synthesis_manager.hpp"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Parametrizations accepted with the lowest Cost found so far, in the order of their numbers.
+///
+/// With cost minimization, the parametrizations are output only once the lowest Cost is known. Each parametrization accepted with a lower Cost
+/// than the current bound lowers the bound and drops those that have a higher Cost. The analysis depends on the bound,
+/// therefore the parametrizations that were accepted before the bound has dropped are checked again at the end.
+/// @attention With counting of the accepting states, a parametrization rejected under a higher bound may be accepted under the lower one,
+/// the computation then has to be restarted with an empty buffer instead.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class MinimalBuffer {
+public:
+   /// A parametrization accepted with the lowest Cost found so far.
+   struct MinimalParam {
+      ParamNo param_no;
+      size_t bound; ///< The bound under which the parametrization was accepted.
+      RoundResults::Member result;
+   };
+
+private:
+   size_t BFS_bound; ///< The current bound on the Cost.
+   vector<MinimalParam> minimal;
+
+public:
+   /**
+    * @param _BFS_bound	the initial bound on the Cost
+    */
+   MinimalBuffer(const size_t _BFS_bound) : BFS_bound(_BFS_bound) {}
+
+   /**
+    * Store the accepted parametrization, if its Cost is lower than the bound, the bound drops and the parametrizations with a higher Cost are dropped.
+    * @param result	outcome obtained under the current bound, even if its Cost lowers the bound, its analysis is still that of the current bound
+    * @return true if the bound has dropped
+    */
+   bool add(const ParamNo param_no, RoundResults::Member result) {
+      const size_t bound = BFS_bound;
+      const bool dropped = result.cost < BFS_bound;
+      if (dropped) {
+         output_streamer.clear_line(verbose_str);
+         output_streamer.output(verbose_str, "New lowest bound on Cost has been found. The current Cost is: " + to_string(result.cost));
+         BFS_bound = result.cost;
+         minimal.erase(remove_if(minimal.begin(), minimal.end(), [this](const MinimalParam & param) {
+            return param.result.cost > BFS_bound;
+         }), minimal.end());
+      }
+      minimal.push_back({ param_no, bound, move(result) });
+      return dropped;
+   }
+
+   /**
+    * Check the parametrizations that were accepted before the bound has dropped again under the current bound, those that are rejected are dropped.
+    */
+   void resolve(SynthesisManager & synthesis_manager, const UserOptions & user_options, const PropertyAutomaton & property) {
+      for (MinimalParam & param : minimal) {
+         if (param.bound != BFS_bound) {
+            synthesis_manager.resolveMember(param.result, param.param_no, BFS_bound, user_options, property);
+            param.bound = BFS_bound;
+         }
+      }
+      minimal.erase(remove_if(minimal.begin(), minimal.end(), [](const MinimalParam & param) {
+         return param.result.cost == INF;
+      }), minimal.end());
+   }
+
+   inline size_t getBound() const {
+      return BFS_bound;
+   }
+
+   inline const vector<MinimalParam> & getParams() const {
+      return minimal;
+   }
+};
+
+#endif // PARSYBONE_MINIMAL_BUFFER_INCLUDED
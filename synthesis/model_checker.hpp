@@ -10,55 +10,183 @@
 #define PARSYBONE_MODEL_CHECKER_INCLUDED
 
 #include "../auxiliary/common_functions.hpp"
+#include "../auxiliary/stamped_vector.hpp"
 #include "color_storage.hpp"
 #include "coloring_func.hpp"
 #include "synthesis_results.hpp"
 #include "checker_setting.hpp"
+#include "level_workers.hpp"
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// \brief Main class of the computation - responsible for the CMC procedure.
 ///
 /// ModelChecker class solves the parameter synthesis problem by iterative transfer of feasible parametrizations from initial states to final ones.
 /// Functions in model checker use many supporting variables and therefore are quite long, it would not make sense to split them, though.
+///
+/// A single parametrization is checked by a level-synchronous BFS that is direction-optimizing: a level with a small frontier is pushed to the successors,
+/// while a level whose frontier covers a large share of the states not yet reached is pulled by the unreached states from their predecessors,
+/// which can stop at the first predecessor found in the frontier.
+/// The levels of a single check can be split between multiple threads, which claim the states they color in a shared bitmap and collect the next level separately.
+/// A check of a finite property can be guided by a backward BFS from the final states, after which the forward one enters only the states that lie on some path
+/// to a final state within the bound.
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 class ModelChecker {
    // Information
    const ProductStructure & product; ///< Product on which the computation will be conducted.
    CheckerSettings settings; ///< Setup for the process.
+   Levels context_values; ///< Targets of the contexts under the checked parametrization, decoded at the start of the check.
 
    // Coloring storage
    ColorStorage & storage; ///< Class that actually stores colors during the computation.
    // ColorStorage next_round_storage; ///< Class that stores updated colors for next round (prevents multiple transitions through one BFS round).
    vector<StateID> updates; ///< Set of states that need to spread their updates.
    vector<StateID> next_updates; ///< Updates that are sheduled forn the next round.
+   vector<atomic<ParamMask> > frontier; ///< Bitmap of the states in updates (MASK_WIDTH states per word), filled only for a bottom-up level.
+   size_t unvisited_edges; ///< Number of the transitions and loops that lead to the states not colored yet in the current check.
+   vector<ParamMask> update_masks; ///< For a block check, parametrizations that the states in updates need to spread.
+   vector<ParamMask> next_masks; ///< For a block check, parametrizations that the states in next_updates will need to spread.
+   vector<ParamSet> update_sets; ///< For an interval check, parametrizations that the states in updates need to spread.
+   vector<ParamSet> next_sets; ///< For an interval check, parametrizations that the states in next_updates will need to spread.
+
+   // Threads sharing the levels
+   /// Results of a level obtained by a single worker.
+   struct LevelPart {
+      vector<StateID> updates; ///< States colored by the worker, scheduled for the next level.
+      vector<StateID> finals; ///< Final states of the current level found by the worker.
+      size_t edges; ///< Transitions and loops leading to the colored states.
+      size_t out_edges; ///< Transitions and loops leaving the colored states.
+   };
+   unique_ptr<LevelWorkers> workers; ///< If set, each level of a check is split between the workers.
+   size_t range_size; ///< Number of the items of a level a worker takes at once.
+   vector<atomic<ParamMask> > visited; ///< Bitmap of the colored states, a worker claims a state by setting its bit. Used only with the workers.
+   vector<LevelPart> parts;
+
+   // Snapshot of the last check from all the initial states, from which the next such check is resumed
+   bool incremental; ///< Should the checks from all the initial states be resumed from the snapshot?
+   bool recording; ///< Is the current check recorded into the snapshot?
+   bool snapshot_valid;
+   CheckerSettings snapshot_settings;
+   Levels snapshot_values; ///< Targets of the contexts for the parametrization of the snapshot.
+   vector<StateID> snapshot_order; ///< States of the snapshot level after level, in the order they were spread.
+   vector<size_t> snapshot_levels; ///< Position in snapshot_order at which each level starts.
+   vector<size_t> state_levels; ///< Level at which each state was spread in the snapshot, INF if it was not.
+   map<StateID, size_t> snapshot_found; ///< Final states found in the snapshot.
+   vector<vector<pair<StateID, size_t> > > context_transitions; ///< Transitions of the KS (state and number) that use each context.
+
+   // Transitions read by the checks since startConsulting, the Cost depends only on the targets of their contexts
+   bool consulting; ///< Are the reached states collected?
+   vector<char> consulted; ///< Marks of the KS states whose transitions have been read.
+   vector<StateID> consulted_states; ///< KS states whose transitions have been read.
+   size_t context_words; ///< Number of the words of a bitmap of the contexts.
+   vector<ParamMask> state_contexts; ///< Bitmap of the contexts of the transitions of each KS state, context_words per state.
+
+   // States from which a final state can be reached, computed before a guided check
+   bool guided; ///< Does the current check enter only the viable states?
+   StampedVector<char> viable; ///< States from which a final state can be reached within the bound, those set since the last reset.
+   vector<StateID> viable_level; ///< States of the current level of the backward BFS.
+   vector<StateID> next_viable; ///< States of the next level of the backward BFS.
 
    // BFS boundaries
    size_t BFS_level; ///< Number of current BFS level during coloring, starts from 0, meaning 0 transitions.
    SynthesisResults results;
+   BlockResults block_results;
+   IntervalResults interval_results;
+
+   /// The frontier is pulled if it leaves through more than 1/PULL_RATIO of the edges that lead to the states not yet colored, as in [Beamer et al. 2012],
+   /// and through more edges than there are states, since the bottom-up round has to go through all of them.
+   static const size_t PULL_RATIO = 14;
+
+   /**
+    * Color the state and if it has not been colored before, schedule it for the next round.
+    */
+   inline void reach(const StateID ID) {
+      if (guided && !viable.isSet(ID))
+         return;
+      if (storage.update(ID)) {
+         next_updates.push_back(ID);
+         unvisited_edges -= product.getInDegree(ID);
+      }
+   }
+
+   /**
+    * Color the state by the worker, unless another worker has already done so, and schedule it for the next round within the part of the worker.
+    */
+   inline void claim(LevelPart & part, const StateID ID) {
+      const ParamMask bit = static_cast<ParamMask>(1) << (ID % MASK_WIDTH);
+      if (visited[ID / MASK_WIDTH].fetch_or(bit, memory_order_relaxed) & bit)
+         return;
+      storage.update(ID); // Only the worker that has claimed the state writes it.
+      part.updates.push_back(ID);
+      part.edges += product.getInDegree(ID);
+      part.out_edges += product.getOutDegree(ID);
+   }
+
+   inline bool isClaimed(const StateID ID) const {
+      return (visited[ID / MASK_WIDTH].load(memory_order_relaxed) >> (ID % MASK_WIDTH)) & 1;
+   }
+
+   /**
+    * @return number of the transitions and loops leaving the states in updates
+    */
+   size_t getFrontierEdges() const {
+      size_t frontier_edges = 0;
+      for (const StateID ID : updates)
+         frontier_edges += product.getOutDegree(ID);
+      return frontier_edges;
+   }
+
+   /**
+    * @return true if the round is cheaper to conduct bottom-up
+    */
+   bool isPullCheaper(const size_t frontier_edges) const {
+      return frontier_edges > product.getStateCount() && frontier_edges * PULL_RATIO > unvisited_edges;
+   }
 
    /**
     * From the source distribute its parameters and newly colored neighbours shedule for update.
     * @param ID	ID of the source state in the product
-    * @param parameters	parameters that will be distributed
+    * @param transfer	called for each target
     */
-   void transferUpdates(const StateID ID) {
-      // Get passed colors, unique for each sucessor
-      vector<StateID> transports;
-
-      if (ColoringFunc::broadcastParameters(settings.getParamNo(), product.getStructure(), product.getKSID(ID)).empty())
-         transports = product.getLoops(ID) ;
+   template <class Transfer>
+   void transferUpdates(const StateID ID, Transfer && transfer) {
+      if (ColoringFunc::isStable(context_values, product.getStructure(), product.getKSID(ID)))
+         product.forEachLoop(ID, transfer);
       else
-         transports = ColoringFunc::broadcastParameters(settings.getParamNo(), product, ID);
-
-      // For all passed values make update on target
-      for (const StateID trans : transports) {
-         // If something new is added to the target, schedule it for an update
-         if (storage.isFound(trans)) {
-            // Determine what is necessary to update
-            storage.update(trans);
-            next_updates.push_back(trans);
-         }
-      }
+         ColoringFunc::forEachSuccessor(context_values, product, ID, transfer);
+   }
+
+   inline void addToFrontier(const StateID ID) {
+      frontier[ID / MASK_WIDTH].fetch_or(static_cast<ParamMask>(1) << (ID % MASK_WIDTH), memory_order_relaxed);
+   }
+
+   inline bool isInFrontier(const StateID ID) const {
+      return (frontier[ID / MASK_WIDTH].load(memory_order_relaxed) >> (ID % MASK_WIDTH)) & 1;
+   }
+
+   /**
+    * @return true if the state can be entered from some state of the frontier under the current parametrization
+    */
+   bool isPulled(const StateID ID) const {
+      return product.anyPredecessor(ID, [this](const StateID source_ID, const TransConst & trans_const) {
+            return isInFrontier(source_ID) && ColoringFunc::isOpen(context_values, trans_const);
+         })
+         || product.anyLoopPredecessor(ID, [this](const StateID source_ID) {
+            return isInFrontier(source_ID) && ColoringFunc::isStable(context_values, product.getStructure(), product.getKSID(source_ID));
+         });
+   }
+
+   /**
+    * Bottom-up round - each state that has not been colored yet searches its predecessors for a state of the frontier.
+    */
+   void pullUpdates() {
+      for (atomic<ParamMask> & word : frontier)
+         word.store(0, memory_order_relaxed);
+      for (const StateID ID : updates)
+         addToFrontier(ID);
+
+      for (const StateID ID : crange(product.getStateCount()))
+         if (!storage.getColor(ID) && (!guided || viable.isSet(ID)) && isPulled(ID))
+            reach(ID);
    }
 
    /**
@@ -66,21 +194,244 @@ class ModelChecker {
     * Executed as an BFS - in rounds.
     */
    void doColoring() {
-      StateID ID = updates.back();
-      updates.pop_back();
+      while (!updates.empty()) {
+         if (recording)
+            recordLevel();
+         if (consulting)
+            consultLevel();
+         // Check if this is not the last round
+         for (const StateID ID : updates)
+            if (settings.isFinal(ID, product) && storage.getColor(ID))
+               results.found_depth.insert({ID, BFS_level});
+
+         if (isPullCheaper(getFrontierEdges()))
+            pullUpdates();
+         else
+            for (const StateID ID : updates)
+               transferUpdates(ID, [this](const StateID target) { reach(target); });
+         updates.clear();
+
+         // If there this round is finished, but there are still paths to find
+         if (BFS_level < settings.getBound()) {
+            if (settings.mimizeCost() && results.isAccepting(settings.minimal_count, INF))
+               return;
+            swap(updates, next_updates);
+            BFS_level++; // Increase level
+         }
+         next_updates.clear();
+      }
+   }
+
+   /**
+    * Mark the source as viable and if it has not been before, schedule it for the next level of the backward BFS.
+    */
+   inline void reachBackward(const StateID ID) {
+      if (viable.touch(ID))
+         next_viable.push_back(ID);
+   }
+
+   /**
+    * Backward BFS from the final states over the transitions open under the current parametrization, limited by the bound.
+    * The transitions of each source are read, so the source is consulted.
+    */
+   void computeViable() {
+      viable.reset();
+      viable_level.clear();
+      for (const StateID final_ID : settings.getFinals(product))
+         if (viable.touch(final_ID))
+            viable_level.push_back(final_ID);
+
+      for (size_t level = 0; !viable_level.empty() && level < settings.getBound(); level++) {
+         for (const StateID ID : viable_level) {
+            product.forEachPredecessor(ID, [this](const StateID source_ID, const TransConst & trans_const) {
+               if (consulting)
+                  consult(source_ID);
+               if (!viable.isSet(source_ID) && ColoringFunc::isOpen(context_values, trans_const))
+                  reachBackward(source_ID);
+            });
+            product.forEachLoopPredecessor(ID, [this](const StateID source_ID) {
+               if (consulting)
+                  consult(source_ID);
+               if (!viable.isSet(source_ID) && ColoringFunc::isStable(context_values, product.getStructure(), product.getKSID(source_ID)))
+                  reachBackward(source_ID);
+            });
+         }
+         viable_level.clear();
+         swap(viable_level, next_viable);
+      }
+      viable_level.clear();
+   }
+
+   /**
+    * Mark the KS state of the product state, the transitions of each state of a level are read when the level is spread.
+    */
+   inline void consult(const StateID ID) {
+      const StateID KS_ID = product.getKSID(ID);
+      if (!consulted[KS_ID]) {
+         consulted[KS_ID] = true;
+         consulted_states.push_back(KS_ID);
+      }
+   }
+
+   void consultLevel() {
+      for (const StateID ID : updates)
+         consult(ID);
+   }
+
+   /**
+    * Append the states of the current level to the snapshot.
+    */
+   void recordLevel() {
+      snapshot_levels.push_back(snapshot_order.size());
+      for (const StateID ID : updates) {
+         snapshot_order.push_back(ID);
+         state_levels[ID] = BFS_level;
+      }
+   }
+
+   /**
+    * Drop the states of the snapshot from the given level on.
+    */
+   void truncateSnapshot(const size_t level) {
+      const size_t begin = level < snapshot_levels.size() ? snapshot_levels[level] : snapshot_order.size();
+      for (const StateID ID : boost::make_iterator_range(snapshot_order.begin() + begin, snapshot_order.end()))
+         state_levels[ID] = INF;
+      snapshot_order.resize(begin);
+      snapshot_levels.resize(min(level, snapshot_levels.size()));
+   }
+
+   /**
+    * @return true if the check is the same as that of the snapshot up to the parametrization, so that it can be resumed from it
+    */
+   bool isResumable() const {
+      return snapshot_valid && !snapshot_levels.empty() && settings.minimize_cost == snapshot_settings.minimize_cost && settings.minimal_count == snapshot_settings.minimal_count;
+   }
+
+   /**
+    * The levels of the BFS up to the first state with a transition whose openness has changed are the same as in the snapshot,
+    * including the level of that state, which only spreads differently.
+    * @return the level of the snapshot from which the check has to be conducted again
+    */
+   size_t getResumeLevel() {
+      const UnparametrizedStructure & structure = product.getStructure();
+      if (context_transitions.empty()) {
+         context_transitions.resize(structure.getContexts().size());
+         for (const StateID KS_ID : crange(structure.getStateCount()))
+            for (const size_t trans_no : crange(structure.getTransitionCount(KS_ID)))
+               context_transitions[structure.getTransitionConst(KS_ID, trans_no).context].push_back({ KS_ID, trans_no });
+      }
+
+      size_t resume = min(snapshot_levels.size() - 1, settings.getBound());
+      for (const size_t context_no : cscope(context_values)) {
+         if (context_values[context_no] == snapshot_values[context_no])
+            continue;
+         for (const pair<StateID, size_t> & transition : context_transitions[context_no]) {
+            const TransConst & trans_const = structure.getTransitionConst(transition.first, transition.second);
+            if (ColoringFunc::isOpen(context_values, trans_const) == ColoringFunc::isOpen(snapshot_values, trans_const))
+               continue;
+            // The transition and the loops of the KS state have changed for all the states of the product with that KS state.
+            for (const StateID BA_ID : crange(product.getAutomaton().getStateCount())) {
+               const StateID ID = product.getProductID(transition.first, BA_ID);
+               if (ID != INF)
+                  resume = min(resume, state_levels[ID]);
+            }
+            if (resume == 0)
+               return resume;
+         }
+      }
+      return resume;
+   }
+
+   /**
+    * Restore the coloring of the snapshot up to the level, which becomes the current one.
+    */
+   void resumeSnapshot(const size_t level) {
+      truncateSnapshot(level + 1);
+      storage.reset();
+      next_updates.clear();
+      BFS_level = level;
+      unvisited_edges = product.getPredecessorCount();
+      for (const StateID ID : snapshot_order) {
+         storage.update(ID);
+         unvisited_edges -= product.getInDegree(ID);
+         if (consulting)
+            consult(ID);
+      }
+      updates.assign(snapshot_order.begin() + snapshot_levels[level], snapshot_order.end());
+      truncateSnapshot(level);
+
+      results = SynthesisResults();
+      for (const pair<const StateID, size_t> & final : snapshot_found)
+         if (final.second < level)
+            results.found_depth.insert(final);
+   }
 
-      // Check if this is not the last round
-      if (settings.isFinal(ID, product) && storage.getColor(ID))
-         results.found_depth.insert({ID, BFS_level});
+   /**
+    * Conduct a single level by the workers - the frontier is split between them and each of them collects the states it has colored.
+    * The parts of the workers are then merged into the next level.
+    * @return number of the transitions and loops leaving the next level
+    */
+   size_t spreadShared(const bool pull) {
+      if (pull)
+         workers->forEach(frontier.size(), range_size, [this](const size_t, const size_t begin, const size_t end) {
+            for (const size_t word : crange(begin, end))
+               frontier[word].store(0, memory_order_relaxed);
+         });
 
-      transferUpdates(ID);
+      workers->forEach(updates.size(), range_size, [this, pull](const size_t worker, const size_t begin, const size_t end) {
+         LevelPart & part = parts[worker];
+         for (const StateID ID : boost::make_iterator_range(updates.begin() + begin, updates.begin() + end)) {
+            if (settings.isFinal(ID, product) && storage.getColor(ID))
+               part.finals.push_back(ID);
+            if (pull)
+               addToFrontier(ID);
+            else
+               transferUpdates(ID, [this, &part](const StateID target) { claim(part, target); });
+         }
+      });
+
+      // Each worker takes whole words of the bitmap, so that the bits of a word are claimed by a single worker.
+      if (pull)
+         workers->forEach(frontier.size(), range_size, [this](const size_t worker, const size_t begin, const size_t end) {
+            LevelPart & part = parts[worker];
+            for (const StateID ID : crange(begin * MASK_WIDTH, min(end * MASK_WIDTH, product.getStateCount())))
+               if (!isClaimed(ID) && isPulled(ID))
+                  claim(part, ID);
+         });
 
-      // If there this round is finished, but there are still paths to find
-      if (updates.empty() && (BFS_level < settings.getBound())) {
-		  if (settings.mimizeCost() && results.isAccepting(settings.minimal_count, INF))
-			  return;
-         updates = move(next_updates);
-         BFS_level++; // Increase level
+      size_t frontier_edges = 0;
+      for (LevelPart & part : parts) {
+         for (const StateID ID : part.finals)
+            results.found_depth.insert({ID, BFS_level});
+         next_updates.insert(next_updates.end(), part.updates.begin(), part.updates.end());
+         unvisited_edges -= part.edges;
+         frontier_edges += part.out_edges;
+         part.updates.clear();
+         part.finals.clear();
+         part.edges = part.out_edges = 0;
+      }
+      return frontier_edges;
+   }
+
+   /**
+    * Same as doColoring, but each level is split between the workers.
+    */
+   void doSharedColoring() {
+      size_t frontier_edges = getFrontierEdges();
+      while (!updates.empty()) {
+         if (consulting)
+            consultLevel();
+         frontier_edges = spreadShared(isPullCheaper(frontier_edges));
+         updates.clear();
+
+         // If there this round is finished, but there are still paths to find
+         if (BFS_level < settings.getBound()) {
+            if (settings.mimizeCost() && results.isAccepting(settings.minimal_count, INF))
+               return;
+            swap(updates, next_updates);
+            BFS_level++; // Increase level
+         }
+         next_updates.clear();
       }
    }
 
@@ -89,8 +440,14 @@ class ModelChecker {
     */
    void prepareObjects() {
       storage.reset();
+      if (workers)
+         workers->forEach(visited.size(), range_size, [this](const size_t, const size_t begin, const size_t end) {
+            for (const size_t word : crange(begin, end))
+               visited[word].store(0, memory_order_relaxed);
+         });
       next_updates.clear(); // Ensure emptiness of the next round
       BFS_level = 0;
+      unvisited_edges = product.getPredecessorCount();
       results = SynthesisResults();
    }
 
@@ -101,11 +458,221 @@ class ModelChecker {
       updates = settings.getInitials(product);
       if (settings.markInitials())
          for (const StateID init_ID : updates)
-            storage.update(init_ID);
+            if (storage.update(init_ID)) {
+               unvisited_edges -= product.getInDegree(init_ID);
+               if (workers)
+                  visited[init_ID / MASK_WIDTH].fetch_or(static_cast<ParamMask>(1) << (init_ID % MASK_WIDTH), memory_order_relaxed);
+            }
+   }
+
+   /**
+    * Add the parametrizations to the target and if there are new ones, schedule the target for an update in the next round.
+    */
+   inline void scheduleBlock(const StateID ID, const ParamMask mask) {
+      if (mask == 0)
+         return;
+      const ParamMask fresh = storage.updateMask(ID, mask);
+      if (fresh == 0)
+         return;
+      if (next_masks[ID] == 0)
+         next_updates.push_back(ID);
+      next_masks[ID] |= fresh;
+   }
+
+   /**
+    * Block version of the transferUpdates - distributes all the parametrizations of the block in the mask at once.
+    */
+   void transferBlock(const StateID ID, const ParamMask mask) {
+      const ParamNo first = settings.getParamNo();
+      const vector<TransContext> & contexts = product.getStructure().getContexts();
+
+      product.forEachTransition(ID, [&](const StateID target_ID, const TransConst & trans_const) {
+         scheduleBlock(target_ID, mask & ColoringFunc::openMask(first, contexts[trans_const.context], trans_const));
+      });
+
+      // The loops are used only by those parametrizations for which the KS state is stable
+      const ParamMask stable = mask & ~ColoringFunc::leavingMask(first, contexts, product.getStructure(), product.getKSID(ID), mask);
+      if (stable != 0)
+         product.forEachLoop(ID, [this, stable](const StateID loop) { scheduleBlock(loop, stable); });
+   }
+
+   /**
+    * @brief prepareBlock   create empty space in the employed objects for a block check
+    */
+   void prepareBlock() {
+      storage.resetMasks();
+      if (update_masks.size() != product.getStateCount()) {
+         update_masks.assign(product.getStateCount(), 0);
+         next_masks.assign(product.getStateCount(), 0);
+      }
+      updates.clear();
+      next_updates.clear();
+      BFS_level = 0;
+      block_results = BlockResults();
+   }
+
+   /**
+    * @brief initiateBlock initiate data for the block check based on the settings
+    */
+   void initiateBlock() {
+      for (const StateID init_ID : settings.getInitials(product)) {
+         if (settings.markInitials())
+            storage.updateMask(init_ID, settings.getMembers());
+         if (update_masks[init_ID] == 0)
+            updates.push_back(init_ID);
+         update_masks[init_ID] |= settings.getMembers();
+      }
+   }
+
+   /**
+    * Interval version of the scheduleBlock.
+    */
+   inline void scheduleSet(const StateID ID, const ParamSet & params) {
+      if (params.empty())
+         return;
+      const ParamSet fresh = storage.updateSet(ID, params);
+      if (fresh.empty())
+         return;
+      if (next_sets[ID].empty()) {
+         next_updates.push_back(ID);
+         next_sets[ID] = fresh;
+      }
+      else {
+         next_sets[ID] = ParamSet::unite(next_sets[ID], fresh);
+      }
+   }
+
+   /**
+    * Interval version of the transferUpdates - distributes the parametrizations of the set by whole runs of the same target value.
+    */
+   void transferSet(const StateID ID, const ParamSet & params) {
+      const vector<TransContext> & contexts = product.getStructure().getContexts();
+
+      product.forEachTransition(ID, [&](const StateID target_ID, const TransConst & trans_const) {
+         scheduleSet(target_ID, ColoringFunc::openSet(params, contexts[trans_const.context], trans_const));
+      });
+
+      // The loops are used only by those parametrizations for which the KS state is stable
+      if (product.getLoopCount(ID) == 0)
+         return;
+      const ParamSet stable = ParamSet::subtract(params, ColoringFunc::leavingSet(params, contexts, product.getStructure(), product.getKSID(ID)));
+      if (!stable.empty())
+         product.forEachLoop(ID, [this, &stable](const StateID loop) { scheduleSet(loop, stable); });
+   }
+
+   /**
+    * @brief prepareIntervals   create empty space in the employed objects for an interval check
+    */
+   void prepareIntervals() {
+      storage.resetSets();
+      if (update_sets.size() != product.getStateCount()) {
+         update_sets.assign(product.getStateCount(), ParamSet());
+         next_sets.assign(product.getStateCount(), ParamSet());
+      }
+      updates.clear();
+      next_updates.clear();
+      BFS_level = 0;
+      interval_results = IntervalResults(settings.getParams().getBegin(), static_cast<size_t>(settings.getParams().getEnd() - settings.getParams().getBegin()));
+   }
+
+   /**
+    * @brief initiateIntervals initiate data for the interval check based on the settings
+    */
+   void initiateIntervals() {
+      for (const StateID init_ID : settings.getInitials(product)) {
+         if (settings.markInitials())
+            storage.updateSet(init_ID, settings.getParams());
+         if (update_sets[init_ID].empty())
+            updates.push_back(init_ID);
+         update_sets[init_ID] = ParamSet::unite(update_sets[init_ID], settings.getParams());
+      }
    }
 
 public:
-   ModelChecker(const ProductStructure & _product, ColorStorage & _storage) : product(_product), storage(_storage) {
+   ModelChecker(const ProductStructure & _product, ColorStorage & _storage)
+      : product(_product), storage(_storage), frontier((_product.getStateCount() + MASK_WIDTH - 1) / MASK_WIDTH), range_size(LEVEL_RANGE),
+        incremental(false), recording(false), snapshot_valid(false), consulting(false), context_words(0), guided(false), viable(_product.getStateCount()) {
+   }
+
+   /// Number of the items of a level a worker takes at once, a level that is not larger is not split at all.
+   static const size_t LEVEL_RANGE = 1024;
+
+   /**
+    * Split the levels of each following check of a single parametrization between the given number of threads, including the caller.
+    * The block checks are not split.
+    * @param _range_size	number of the items of a level a worker takes at once
+    */
+   void setThreads(const size_t threads_count, const size_t _range_size = LEVEL_RANGE) {
+      range_size = _range_size;
+      if (threads_count <= 1) {
+         workers.reset();
+         visited.clear();
+         parts.clear();
+         return;
+      }
+      workers.reset(new LevelWorkers(threads_count));
+      visited = vector<atomic<ParamMask> >(frontier.size());
+      parts = vector<LevelPart>(threads_count, LevelPart{ {}, {}, 0, 0 });
+   }
+
+   /**
+    * Resume each following check from all the initial states from the snapshot of the last one, only the levels from the first one
+    * that uses a transition whose openness has changed are conducted again. Not used if the levels are split between threads.
+    */
+   void setIncremental(const bool _incremental) {
+      incremental = _incremental;
+      if (!incremental) {
+         snapshot_valid = false;
+         truncateSnapshot(0);
+      }
+   }
+
+   /**
+    * Collect the transitions read by the following checks of single parametrizations.
+    */
+   void startConsulting() {
+      consulting = true;
+      if (!consulted.empty())
+         return;
+      const UnparametrizedStructure & structure = product.getStructure();
+      consulted.assign(structure.getStateCount(), false);
+      context_words = (structure.getContexts().size() + MASK_WIDTH - 1) / MASK_WIDTH;
+      state_contexts.assign(structure.getStateCount() * context_words, 0);
+      for (const StateID KS_ID : crange(structure.getStateCount())) {
+         for (const size_t trans_no : crange(structure.getTransitionCount(KS_ID))) {
+            const size_t context_no = structure.getTransitionConst(KS_ID, trans_no).context;
+            state_contexts[KS_ID * context_words + context_no / MASK_WIDTH] |= static_cast<ParamMask>(1) << (context_no % MASK_WIDTH);
+         }
+      }
+   }
+
+   /**
+    * @return the contexts of the transitions read since startConsulting in ascending order
+    */
+   vector<size_t> stopConsulting() {
+      vector<ParamMask> used(context_words, 0);
+      for (const StateID KS_ID : consulted_states) {
+         consulted[KS_ID] = false;
+         for (const size_t word : crange(context_words))
+            used[word] |= state_contexts[KS_ID * context_words + word];
+      }
+      consulted_states.clear();
+      consulting = false;
+
+      vector<size_t> contexts;
+      for (const size_t word : crange(context_words))
+         for (const size_t bit : crange(MASK_WIDTH))
+            if ((used[word] >> bit) & 1)
+               contexts.push_back(word * MASK_WIDTH + bit);
+      return contexts;
+   }
+
+   /**
+    * @return targets of the contexts under the parametrization, valid until the next check
+    */
+   const Levels & decodeValues(const ParamNo param_no) {
+      ColoringFunc::decode(param_no, product.getStructure().getContexts(), context_values);
+      return context_values;
    }
 
    /**
@@ -113,17 +680,129 @@ public:
     */
    SynthesisResults conductCheck(const CheckerSettings & _settings) {
       settings = _settings;
-      prepareObjects();
-      initiateCheck();
+      ColoringFunc::decode(settings.getParamNo(), product.getStructure().getContexts(), context_values);
+      recording = incremental && !workers && !settings.guide_backward && settings.initial_states.empty() && settings.final_states.empty() && settings.markInitials();
+      // The workers color the states they claim, the guidance is not used with them.
+      guided = settings.guide_backward && !workers;
+      if (guided)
+         computeViable();
+      if (recording && isResumable()) {
+         resumeSnapshot(getResumeLevel());
+      }
+      else {
+         prepareObjects();
+         initiateCheck();
+         if (recording) {
+            if (state_levels.size() != product.getStateCount())
+               state_levels.assign(product.getStateCount(), INF);
+            truncateSnapshot(0);
+         }
+      }
 
       // While there are updates, pass them to succesing vertices
-      do  {
+      if (workers)
+         doSharedColoring();
+      else
          doColoring();
-      } while (!updates.empty());
 
+      if (recording) {
+         snapshot_valid = true;
+         snapshot_settings = settings;
+         snapshot_values = context_values;
+         snapshot_found = results.found_depth;
+      }
+      recording = guided = false;
       results.derive();
       return results;
    }
+
+   /**
+    * Conduct the coloring for all the members of the block at once. Each parametrization is treated exactly as it would be by conductCheck,
+    * i.e. it stops being spread once it has found enough final states (if cost is minimized) or the bound is reached.
+    */
+   BlockResults conductBlockCheck(const CheckerSettings & _settings) {
+      settings = _settings;
+      prepareBlock();
+      initiateBlock();
+      ParamMask active = settings.getMembers(); ///< Parametrizations that are still being spread.
+
+      while (!updates.empty()) {
+         for (const StateID ID : updates) {
+            const ParamMask mask = update_masks[ID] & active;
+            update_masks[ID] = 0;
+            if (mask == 0)
+               continue;
+
+            const ParamMask colored = mask & storage.getMask(ID);
+            if (colored != 0 && settings.isFinal(ID, product))
+               block_results.add(ID, BFS_level, colored);
+
+            transferBlock(ID, mask);
+         }
+         updates.clear();
+
+         // Parametrizations that have already found enough final states do not continue.
+         if (settings.mimizeCost())
+            active &= ~block_results.getAccepting(active, settings.getMinCount(), INF);
+         if (BFS_level < settings.getBound() && active != 0) {
+            swap(updates, next_updates);
+            swap(update_masks, next_masks);
+            BFS_level++;
+         }
+
+         // Remove the updates that are not going to be conducted.
+         for (const StateID ID : next_updates)
+            next_masks[ID] = 0;
+         next_updates.clear();
+      }
+
+      return block_results;
+   }
+
+   /**
+    * Conduct the coloring for all the parametrizations of the set at once, the same as conductBlockCheck, but the parametrizations
+    * are carried as intervals, so that their number is not limited by MASK_WIDTH.
+    */
+   IntervalResults conductIntervalCheck(const CheckerSettings & _settings) {
+      settings = _settings;
+      prepareIntervals();
+      initiateIntervals();
+      ParamSet active = settings.getParams(); ///< Parametrizations that are still being spread.
+
+      while (!updates.empty()) {
+         for (const StateID ID : updates) {
+            const ParamSet params = ParamSet::intersect(update_sets[ID], active);
+            update_sets[ID].clear();
+            if (params.empty())
+               continue;
+
+            if (settings.isFinal(ID, product)) {
+               const ParamSet colored = ParamSet::intersect(params, storage.getSet(ID));
+               if (!colored.empty())
+                  interval_results.add(ID, BFS_level, colored);
+            }
+
+            transferSet(ID, params);
+         }
+         updates.clear();
+
+         // Parametrizations that have already found enough final states do not continue.
+         if (settings.mimizeCost())
+            active = ParamSet::subtract(active, interval_results.getAccepting(active, settings.getMinCount(), INF));
+         if (BFS_level < settings.getBound() && !active.empty()) {
+            swap(updates, next_updates);
+            swap(update_sets, next_sets);
+            BFS_level++;
+         }
+
+         // Remove the updates that are not going to be conducted.
+         for (const StateID ID : next_updates)
+            next_sets[ID].clear();
+         next_updates.clear();
+      }
+
+      return interval_results;
+   }
 };
 
 #endif // PARSYBONE_MODEL_CHECKER_INCLUDED
@@ -35,20 +35,6 @@ public:
 		database(_model, _kinetics, _user_options.database_file, _user_options.use_database) {}
 
 public:
-	/**
-	 * @brief eraseData
-	 */
-	void eraseData() {
-		if (user_options.use_textfile) {
-			output_streamer.createStreamFile(results_str, user_options.datatext_file);
-		}
-		if (user_options.use_database) {
-			database.finishOutpout();
-			database.dropTables();
-		}
-		outputForm();
-	}
-
 	/**
 	 * @brief outputForm
 	 */
@@ -0,0 +1,324 @@
+/*
+ * Copyright (C) 2012-2013 - Adam Streck
+ * This file is a part of the ParSyBoNe (Parameter Synthetizer for Boolean Networks) verification tool.
+ * ParSyBoNe is a free software: you can redistribute it and/or modify it under the terms of the GNU General Public License version 3.
+ * ParSyBoNe is released without any warranty. See the GNU General Public License for more details. <http://www.gnu.org/licenses/>.
+ * For affiliations see <http://www.mi.fu-berlin.de/en/math/groups/dibimath> and <http://sybila.fi.muni.cz/>.
+ */
+
+#ifndef PARSYBONE_PARALLEL_MANAGER_INCLUDED
+#define PARSYBONE_PARALLEL_MANAGER_INCLUDED
+
+#include "synthesis_manager.hpp"
+
+/// Computes the rounds ahead of the caller, which consumes them in their order.
+class RoundSource {
+public:
+	/// Obtains the members of the round, it is called in the increasing order of the rounds.
+	typedef function<ParamMask(const RoundNo)> MembersFunc;
+	/// Computes the round with the given members under the given bound.
+	typedef function<RoundResults(SynthesisManager &, const RoundNo, const ParamMask, const size_t)> RoundFunc;
+
+	virtual ~RoundSource() {}
+
+	/**
+	 * Publish a new bound on the Cost, the rounds that are started afterwards use it.
+	 */
+	virtual void setBound(const size_t BFS_bound) = 0;
+
+	/**
+	 * Wait for the round and pass its results, the rounds must be requested in the increasing order.
+	 * @param round	number of the round, starting from 1
+	 */
+	virtual RoundResults getRound(const RoundNo round) = 0;
+
+	/**
+	 * @return description of the work done by the individual workers
+	 */
+	virtual string getLoadReport() = 0;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Computes the rounds of this process by multiple threads that share a single ProductStructure.
+///
+/// Each worker owns a SynthesisManager and a chunk of consecutive rounds it computes from the front. A worker that has emptied its chunk takes a new one
+/// and if there are no more rounds, it steals the back half of the largest chunk of another worker.
+/// The size of a new chunk is guided by the rounds that remain (half of them divided between the workers) and by the measured time of a round,
+/// so that a chunk takes about CHUNK_TIME. Chunks are therefore large while the costs are low and shrink towards the end of the computation.
+/// The results are handed over to the caller strictly in the order of the rounds, so that the output does not depend on the number of threads.
+/// Workers are not allowed to run further ahead of the caller than a fixed window of rounds.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class ParallelManager : public RoundSource {
+	/// Rounds [begin, end) owned by a worker together with their members.
+	struct Chunk {
+		RoundNo begin;
+		RoundNo end;
+		deque<ParamMask> members;
+	};
+
+	/// Work done by a single worker.
+	struct WorkerStats {
+		RoundNo rounds; ///< Rounds computed.
+		size_t chunks; ///< Chunks of fresh rounds taken.
+		size_t steals; ///< Chunks stolen from the others.
+		double busy; ///< Seconds spent computing the rounds.
+		double chunk_busy; ///< Seconds spent on the rounds since the last fresh chunk was taken.
+		RoundNo chunk_rounds; ///< Rounds computed since the last fresh chunk was taken.
+		size_t cache_hits; ///< Costs found in the cache of the worker.
+		size_t cache_lookups; ///< Parametrizations looked up in the cache of the worker.
+	};
+
+	static const RoundNo MAX_CHUNK = 256; ///< Upper bound on the size of a chunk.
+	static constexpr double CHUNK_TIME = 0.01; ///< Time in seconds a chunk should take.
+
+	const MembersFunc get_members;
+	const RoundFunc compute;
+	const RoundNo rounds_count; ///< Rounds are numbered from 1 to rounds_count.
+	const size_t threads_count;
+	const RoundNo window; ///< How far a worker may get ahead of the consumed round.
+	atomic<size_t> bound; ///< The current bound on the Cost, published by the caller and, if shared, by the workers.
+
+	mutex source_mutex; ///< Guards the rounds that have not been assigned yet.
+	RoundNo next_round; ///< The first round not assigned to any worker.
+	double round_time; ///< Estimate of the time a round takes, 0 until the first chunk is measured.
+	vector<unique_ptr<mutex> > chunk_mutexes;
+	vector<Chunk> chunks;
+
+	mutex results_mutex; ///< Guards all the data below.
+	condition_variable results_cond;
+	map<RoundNo, RoundResults> results; ///< Computed rounds that have not been consumed yet.
+	RoundNo consumed; ///< The last round that has been consumed.
+	bool stopped;
+	exception_ptr failure; ///< The first exception thrown by a worker.
+	vector<WorkerStats> stats;
+
+	vector<unique_ptr<SynthesisManager> > managers;
+	vector<thread> workers;
+
+	/* Take the first round of the chunk, if there is any. */
+	bool popRound(const size_t worker, RoundNo & round, ParamMask & members) {
+		lock_guard<mutex> lock(*chunk_mutexes[worker]);
+		Chunk & chunk = chunks[worker];
+		if (chunk.begin == chunk.end)
+			return false;
+		round = chunk.begin++;
+		members = chunk.members.front();
+		chunk.members.pop_front();
+		return true;
+	}
+
+	/* Update the estimate of the round time by the rounds computed by the worker since its last fresh chunk. */
+	void measureChunk(const size_t worker) {
+		lock_guard<mutex> lock(results_mutex);
+		WorkerStats & worker_stats = stats[worker];
+		if (worker_stats.chunk_rounds == 0)
+			return;
+		const double measured = worker_stats.chunk_busy / worker_stats.chunk_rounds;
+		round_time = round_time == 0. ? measured : (round_time + measured) / 2.;
+		worker_stats.chunk_busy = 0.;
+		worker_stats.chunk_rounds = 0;
+	}
+
+	/* Number of rounds the next fresh chunk should have, the first chunks have a single round only, until there is a measurement. */
+	RoundNo getChunkSize() const {
+		const RoundNo remaining = rounds_count + 1 - next_round;
+		RoundNo chunk_size = remaining / (2 * threads_count);
+		if (round_time == 0.)
+			chunk_size = 1;
+		else if (CHUNK_TIME / round_time < chunk_size)
+			chunk_size = static_cast<RoundNo>(CHUNK_TIME / round_time);
+		return max(static_cast<RoundNo>(1), min(static_cast<RoundNo>(MAX_CHUNK), chunk_size));
+	}
+
+	/* Assign a chunk of fresh rounds to the worker. */
+	bool takeFresh(const size_t worker) {
+		lock_guard<mutex> source_lock(source_mutex);
+		if (next_round > rounds_count)
+			return false;
+		measureChunk(worker);
+
+		Chunk chunk;
+		chunk.begin = next_round;
+		chunk.end = min(next_round + getChunkSize(), rounds_count + 1);
+		for (RoundNo round = chunk.begin; round < chunk.end; round++)
+			chunk.members.push_back(get_members(round));
+		next_round = chunk.end;
+
+		lock_guard<mutex> lock(*chunk_mutexes[worker]);
+		chunks[worker] = move(chunk);
+		lock_guard<mutex> stats_lock(results_mutex);
+		stats[worker].chunks++;
+		return true;
+	}
+
+	/* Move the back half of the largest chunk of the other workers to this worker. */
+	bool steal(const size_t worker) {
+		// Find the worker with the most rounds left.
+		size_t victim = worker;
+		RoundNo largest = 0;
+		for (const size_t other : cscope(chunks)) {
+			if (other == worker)
+				continue;
+			lock_guard<mutex> lock(*chunk_mutexes[other]);
+			if (chunks[other].end - chunks[other].begin > largest) {
+				largest = chunks[other].end - chunks[other].begin;
+				victim = other;
+			}
+		}
+		if (victim == worker)
+			return false;
+
+		// The chunk may have shrunk in between, then the search is repeated by the caller.
+		Chunk stolen;
+		{
+			lock_guard<mutex> lock(*chunk_mutexes[victim]);
+			Chunk & chunk = chunks[victim];
+			const RoundNo count = (chunk.end - chunk.begin + 1) / 2;
+			stolen.end = chunk.end;
+			stolen.begin = chunk.end = chunk.end - count;
+			stolen.members.assign(chunk.members.end() - count, chunk.members.end());
+			chunk.members.erase(chunk.members.end() - count, chunk.members.end());
+		}
+
+		lock_guard<mutex> lock(*chunk_mutexes[worker]);
+		chunks[worker] = move(stolen);
+		lock_guard<mutex> stats_lock(results_mutex);
+		stats[worker].steals++;
+		return true;
+	}
+
+	/* Obtain a round to compute, false if there is none left. */
+	bool takeRound(const size_t worker, RoundNo & round, ParamMask & members) {
+		while (!isStopped()) {
+			if (popRound(worker, round, members))
+				return true;
+			if (!takeFresh(worker) && !steal(worker))
+				return false;
+		}
+		return false;
+	}
+
+	bool isStopped() {
+		lock_guard<mutex> lock(results_mutex);
+		return stopped;
+	}
+
+	/* Compute the rounds until there are none left. */
+	void work(const size_t worker) {
+		try {
+			RoundNo round;
+			ParamMask members;
+			while (takeRound(worker, round, members)) {
+				{
+					unique_lock<mutex> lock(results_mutex);
+					results_cond.wait(lock, [this, round]() { return stopped || round <= consumed + window; });
+					if (stopped)
+						return;
+				}
+
+				const auto start = chrono::steady_clock::now();
+				RoundResults round_results = compute(*managers[worker], round, members, bound.load());
+				const double busy = chrono::duration_cast<chrono::duration<double> >(chrono::steady_clock::now() - start).count();
+
+				lock_guard<mutex> lock(results_mutex);
+				results.insert(make_pair(round, move(round_results)));
+				WorkerStats & worker_stats = stats[worker];
+				worker_stats.rounds++;
+				worker_stats.busy += busy;
+				worker_stats.chunk_busy += busy;
+				worker_stats.chunk_rounds++;
+				worker_stats.cache_hits = managers[worker]->getCache().getHitCount();
+				worker_stats.cache_lookups = managers[worker]->getCache().getLookupCount();
+				results_cond.notify_all();
+			}
+		}
+		catch (...) {
+			lock_guard<mutex> lock(results_mutex);
+			if (!failure)
+				failure = current_exception();
+			stopped = true;
+			results_cond.notify_all();
+		}
+	}
+
+public:
+	NO_COPY(ParallelManager)
+
+	/**
+	 * Start the workers, each of them builds its own SynthesisManager over the shared product.
+	 * @param _threads_count	number of the workers
+	 * @param _rounds_count	number of the rounds of this process
+	 * @param BFS_bound	the initial bound on the Cost
+	 * @param share_bound	if true, the workers check against the current bound and lower it by each Cost they find
+	 */
+	ParallelManager(const size_t _threads_count, const ProductStructure & product, const RoundNo _rounds_count, const size_t BFS_bound, const bool share_bound, MembersFunc _get_members, RoundFunc _compute)
+		: get_members(move(_get_members)), compute(move(_compute)), rounds_count(_rounds_count), threads_count(_threads_count),
+		window(MAX_CHUNK * _threads_count * 2), bound(BFS_bound), next_round(1), round_time(0.), chunks(threads_count), consumed(0), stopped(false),
+		stats(threads_count, WorkerStats{ 0, 0, 0, 0., 0., 0, 0, 0 }) {
+		for (const size_t worker : crange(threads_count)) {
+			chunk_mutexes.emplace_back(new mutex);
+			chunks[worker].begin = chunks[worker].end = 0;
+			managers.emplace_back(new SynthesisManager(product));
+			if (share_bound)
+				managers.back()->shareBound(&bound);
+		}
+		for (const size_t worker : crange(threads_count))
+			workers.emplace_back(&ParallelManager::work, this, worker);
+	}
+
+	~ParallelManager() {
+		{
+			lock_guard<mutex> lock(results_mutex);
+			stopped = true;
+			results_cond.notify_all();
+		}
+		for (thread & worker : workers)
+			worker.join();
+	}
+
+	void setBound(const size_t BFS_bound) override {
+		SynthesisManager::lowerBound(bound, BFS_bound);
+	}
+
+	RoundResults getRound(const RoundNo round) override {
+		unique_lock<mutex> lock(results_mutex);
+		results_cond.wait(lock, [this, round]() { return failure || results.count(round) > 0; });
+		if (failure)
+			rethrow_exception(failure);
+
+		auto result_it = results.find(round);
+		RoundResults round_results = move(result_it->second);
+		results.erase(result_it);
+		consumed = round;
+		results_cond.notify_all();
+
+		return round_results;
+	}
+
+	/**
+	 * @return description of the work done by the workers, the imbalance is the ratio of the longest and the average busy time of a worker
+	 */
+	string getLoadReport() override {
+		lock_guard<mutex> lock(results_mutex);
+		double total_busy = 0., max_busy = 0.;
+		size_t chunks_count = 0, steals_count = 0, cache_hits = 0, cache_lookups = 0;
+		string rounds;
+		for (const WorkerStats & worker_stats : stats) {
+			cache_hits += worker_stats.cache_hits;
+			cache_lookups += worker_stats.cache_lookups;
+			total_busy += worker_stats.busy;
+			max_busy = max(max_busy, worker_stats.busy);
+			chunks_count += worker_stats.chunks;
+			steals_count += worker_stats.steals;
+			rounds += (rounds.empty() ? "" : "/") + to_string(worker_stats.rounds);
+		}
+		const double mean_busy = total_busy / stats.size();
+		const double imbalance = mean_busy > 0. ? max_busy / mean_busy : 1.;
+
+		return "Threads load: rounds " + rounds + ", chunks " + to_string(chunks_count) + ", steals " + to_string(steals_count)
+			+ ", busy time max " + to_string(max_busy) + "s mean " + to_string(mean_busy) + "s, imbalance " + to_string(imbalance) + "."
+			+ (cache_lookups > 0 ? " " + ResultCache::getHitReport(cache_hits, cache_lookups) : "");
+	}
+};
+
+#endif // PARSYBONE_PARALLEL_MANAGER_INCLUDED
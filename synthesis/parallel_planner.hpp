@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2012-2013 - Adam Streck
+ * This file is a part of the ParSyBoNe (Parameter Synthetizer for Boolean Networks) verification tool.
+ * ParSyBoNe is a free software: you can redistribute it and/or modify it under the terms of the GNU General Public License version 3.
+ * ParSyBoNe is released without any warranty. See the GNU General Public License for more details. <http://www.gnu.org/licenses/>.
+ * For affiliations see <http://www.mi.fu-berlin.de/en/math/groups/dibimath> and <http://sybila.fi.muni.cz/>.
+ */
+
+#ifndef PARSYBONE_PARALLEL_PLANNER_INCLUDED
+#define PARSYBONE_PARALLEL_PLANNER_INCLUDED
+
+#include "synthesis_manager.hpp"
+
+#include <unistd.h>
+
+/// Division of the computation chosen by the ParallelPlanner.
+struct ParallelPlan {
+	size_t threads_count; ///< Threads that check distinct parametrizations.
+	size_t bfs_threads_count; ///< Threads that share the BFS of a single parametrization.
+	size_t block_size; ///< Parametrizations checked at once within a single coloring.
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Chooses how the computation is divided between the threads of this process.
+///
+/// The threads either check distinct parametrizations (each of them needs its own copy of the per-state data) or share the BFS of a single one.
+/// The planner checks a sample of the parametrizations in each of the possible ways and measures the throughput. The sample consists of windows
+/// of MASK_WIDTH consecutive parametrizations spread evenly over the space, as the parametrizations close to each other tend to take a similar time:
+///	-# single parametrizations by a single thread,
+///	-# blocks of MASK_WIDTH parametrizations by a single thread, unless the block size has been given,
+///	-# single parametrizations with the BFS split between all the cores, if the product is large enough for the levels to be split.
+/// The threads that check distinct parametrizations are expected to scale almost linearly, but their number is limited by the memory
+/// and by the number of rounds, so that each of them has some work. The results of the calibration are discarded.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class ParallelPlanner {
+	static constexpr double CALIBRATION_TIME = 0.05; ///< Time in seconds after which the first calibration stops, at the end of a window.
+	static const size_t CALIBRATION_WINDOWS = 16; ///< Maximal number of the windows of the sample.
+	static const size_t STATE_BYTES = 64; ///< Estimate of the memory a SynthesisManager needs per state of the product.
+	static const RoundNo THREAD_ROUNDS = 16; ///< Minimal number of rounds per a thread that checks distinct parametrizations.
+	static constexpr double THREAD_EFFICIENCY = 0.9; ///< Expected speedup per a thread that checks distinct parametrizations.
+
+	const ProductStructure & product;
+	const PropertyAutomaton & property;
+	const UserOptions & user_options;
+	string report;
+
+	/**
+	 * Check the windows of the sample in the given way.
+	 * @param[in,out] windows_count	number of the windows to check, if 0, they are checked until CALIBRATION_TIME passes and their number is returned
+	 * @param[out] params_count	number of the parametrizations checked
+	 * @return throughput in parametrizations per second
+	 */
+	double measure(const size_t block_size, const size_t bfs_threads_count, size_t & windows_count, ParamNo & params_count, const ParamNo space_size) const {
+		SynthesisManager manager(product);
+		manager.setBFSThreads(bfs_threads_count);
+		UserOptions calibration = user_options;
+		calibration.block_size = block_size;
+
+		const bool timed = windows_count == 0;
+		const ParamNo window_size = min(static_cast<ParamNo>(MASK_WIDTH), space_size);
+		const size_t limit = timed ? static_cast<size_t>(min(static_cast<ParamNo>(CALIBRATION_WINDOWS), space_size / window_size)) : windows_count;
+		const auto start = chrono::steady_clock::now();
+		double elapsed = 0.;
+		size_t window = 0;
+		for (params_count = 0; window < limit && !(timed && elapsed > CALIBRATION_TIME); window++) {
+			const ParamNo window_begin = (space_size / limit) * window;
+			for (ParamNo first = window_begin; first < window_begin + window_size; first += block_size) {
+				const size_t round_size = static_cast<size_t>(min(static_cast<ParamNo>(block_size), window_begin + window_size - first));
+				const ParamMask members = round_size == MASK_WIDTH ? ~static_cast<ParamMask>(0) : (static_cast<ParamMask>(1) << round_size) - 1;
+				manager.checkRound(first, round_size, members, user_options.bound_size, calibration, property);
+				params_count += round_size;
+			}
+			elapsed = chrono::duration_cast<chrono::duration<double> >(chrono::steady_clock::now() - start).count();
+		}
+
+		windows_count = window;
+		return params_count / max(elapsed, 1e-9);
+	}
+
+	/**
+	 * @return how many SynthesisManagers fit into a half of the physical memory
+	 */
+	size_t getMemoryThreads() const {
+		const long pages = sysconf(_SC_PHYS_PAGES);
+		const long page_size = sysconf(_SC_PAGE_SIZE);
+		if (pages <= 0 || page_size <= 0)
+			return numeric_limits<size_t>::max();
+		const double memory = static_cast<double>(pages) * static_cast<double>(page_size) / 2.;
+		return max(static_cast<size_t>(1), static_cast<size_t>(memory / (static_cast<double>(product.getStateCount()) * STATE_BYTES)));
+	}
+
+public:
+	ParallelPlanner(const ProductStructure & _product, const PropertyAutomaton & _property, const UserOptions & _user_options)
+		: product(_product), property(_property), user_options(_user_options) {}
+
+	/**
+	 * Calibrate and choose the division.
+	 * @param params_count	number of the parametrizations this process checks
+	 */
+	ParallelPlan plan(const ParamNo params_count) {
+		const size_t cores = max(1u, thread::hardware_concurrency());
+		ParallelPlan result = { 1, 1, user_options.block_size };
+		if (params_count == 0) {
+			report = "Parallel plan: a single thread as there are no parametrizations to check.";
+			return result;
+		}
+
+		size_t windows = 0;
+		ParamNo sample = 0;
+		const double single_rate = measure(1, 1, windows, sample, params_count);
+		double serial_rate = single_rate;
+		report = "Calibrated on " + to_string(sample) + " parametrizations: single " + to_string(single_rate) + "/s";
+
+		// All the parametrizations have been checked within the calibration, there is nothing to gain.
+		if (sample == params_count) {
+			report += ". Parallel plan: a single thread as the whole computation takes less than the calibration.";
+			return result;
+		}
+
+		if (user_options.block_size == 1) {
+			const double block_rate = measure(MASK_WIDTH, 1, windows, sample, params_count);
+			report += ", blocks of " + to_string(MASK_WIDTH) + " " + to_string(block_rate) + "/s";
+			if (block_rate > single_rate) {
+				result.block_size = MASK_WIDTH;
+				serial_rate = block_rate;
+			}
+		}
+
+		const RoundNo rounds = (params_count + result.block_size - 1) / result.block_size;
+		result.threads_count = min({ cores, getMemoryThreads(), static_cast<size_t>(max(static_cast<RoundNo>(1), rounds / THREAD_ROUNDS)) });
+		const double threads_rate = serial_rate * (result.threads_count > 1 ? result.threads_count * THREAD_EFFICIENCY : 1.);
+
+		if (cores > 1 && product.getStateCount() > ModelChecker::LEVEL_RANGE) {
+			const double bfs_rate = measure(1, cores, windows, sample, params_count);
+			report += ", BFS split between " + to_string(cores) + " threads " + to_string(bfs_rate) + "/s";
+			if (bfs_rate > threads_rate) {
+				result = { 1, cores, 1 };
+				report += ". Parallel plan: the BFS of each parametrization is split between " + to_string(cores) + " threads.";
+				return result;
+			}
+		}
+
+		report += ". Parallel plan: " + to_string(result.threads_count) + " thread(s) checking distinct parametrizations in blocks of " + to_string(result.block_size)
+			+ ", expected " + to_string(threads_rate) + "/s.";
+		return result;
+	}
+
+	/**
+	 * @return the measured throughputs and the decision made by the last plan
+	 */
+	const string & getReport() const {
+		return report;
+	}
+};
+
+#endif // PARSYBONE_PARALLEL_PLANNER_INCLUDED
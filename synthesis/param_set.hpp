@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2012-2013 - Adam Streck
+ * This file is a part of the ParSyBoNe (Parameter Synthetizer for Boolean Networks) verification tool.
+ * ParSyBoNe is a free software: you can redistribute it and/or modify it under the terms of the GNU General Public License version 3.
+ * ParSyBoNe is released without any warranty. See the GNU General Public License for more details. <http://www.gnu.org/licenses/>.
+ * For affiliations see <http://www.mi.fu-berlin.de/en/math/groups/dibimath> and <http://sybila.fi.muni.cz/>.
+ */
+
+#ifndef PARSYBONE_PARAM_SET_INCLUDED
+#define PARSYBONE_PARAM_SET_INCLUDED
+
+#include "../auxiliary/common_functions.hpp"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief A set of parametrizations stored as sorted intervals of the words of their bitmap, each interval with a single mask for all its words.
+///
+/// The parametrization w * MASK_WIDTH + i is in the set iff the word w lies in some interval whose mask has the i-th bit set.
+/// A target value of a context is constant on the runs of step_size parametrizations, therefore the set of parametrizations for which a transition is open
+/// consists either of long runs of full words (a large step_size), or of words that repeat the same mask (a step_size that divides MASK_WIDTH),
+/// and both of them are kept as a single interval. Neighbouring intervals with the same mask are always joined and empty words are omitted,
+/// so that each set has a single representation. All the operations are linear in the number of the intervals.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class ParamSet {
+public:
+	/// Words [first, last) that all hold the same mask.
+	struct Interval {
+		ParamNo first;
+		ParamNo last;
+		ParamMask mask;
+
+		bool operator==(const Interval & other) const {
+			return first == other.first && last == other.last && mask == other.mask;
+		}
+	};
+
+private:
+	vector<Interval> intervals;
+
+	/**
+	 * Combine the masks of the two sets word by word.
+	 * @param until_first	the result is empty outside of the first set
+	 * @param until_second	the result is empty outside of the second set
+	 */
+	template <class Operation>
+	static ParamSet combine(const ParamSet & first, const ParamSet & second, Operation && operation, const bool until_first, const bool until_second) {
+		ParamSet result;
+		auto first_it = first.intervals.begin(), second_it = second.intervals.begin();
+		ParamNo word = 0;
+
+		while (first_it != first.intervals.end() || second_it != second.intervals.end()) {
+			if ((until_first && first_it == first.intervals.end()) || (until_second && second_it == second.intervals.end()))
+				break;
+			if (first_it != first.intervals.end() && first_it->last <= word) {
+				first_it++;
+				continue;
+			}
+			if (second_it != second.intervals.end() && second_it->last <= word) {
+				second_it++;
+				continue;
+			}
+
+			// The masks of both the sets are constant up to the next boundary.
+			const bool in_first = first_it != first.intervals.end() && first_it->first <= word;
+			const bool in_second = second_it != second.intervals.end() && second_it->first <= word;
+			ParamNo next = numeric_limits<ParamNo>::max();
+			if (first_it != first.intervals.end())
+				next = min(next, in_first ? first_it->last : first_it->first);
+			if (second_it != second.intervals.end())
+				next = min(next, in_second ? second_it->last : second_it->first);
+
+			if (in_first || in_second)
+				result.append(word, next, operation(in_first ? first_it->mask : 0, in_second ? second_it->mask : 0));
+			word = next;
+		}
+
+		return result;
+	}
+
+public:
+	ParamSet() = default;
+
+	/**
+	 * Set of the parametrizations [begin, end).
+	 */
+	ParamSet(const ParamNo begin, const ParamNo end) {
+		if (begin >= end)
+			return;
+		const ParamNo first = begin / MASK_WIDTH, last = (end - 1) / MASK_WIDTH;
+		const ParamMask low = ~static_cast<ParamMask>(0) << (begin % MASK_WIDTH);
+		const ParamMask high = end % MASK_WIDTH == 0 ? ~static_cast<ParamMask>(0) : (static_cast<ParamMask>(1) << (end % MASK_WIDTH)) - 1;
+		if (first == last) {
+			append(first, first + 1, low & high);
+		}
+		else {
+			append(first, first + 1, low);
+			append(first + 1, last, ~static_cast<ParamMask>(0));
+			append(last, last + 1, high);
+		}
+	}
+
+	/**
+	 * Add the mask to the words [first, last) that do not start before the end of the last interval.
+	 */
+	inline void append(const ParamNo first, const ParamNo last, const ParamMask mask) {
+		if (first >= last || mask == 0)
+			return;
+		if (!intervals.empty() && intervals.back().last == first && intervals.back().mask == mask)
+			intervals.back().last = last;
+		else
+			intervals.push_back({ first, last, mask });
+	}
+
+	inline bool empty() const {
+		return intervals.empty();
+	}
+
+	inline void clear() {
+		intervals.clear();
+	}
+
+	inline const vector<Interval> & getIntervals() const {
+		return intervals;
+	}
+
+	/**
+	 * @return the lowest parametrization of the word the set starts with, 0 for an empty set
+	 */
+	inline ParamNo getBegin() const {
+		return intervals.empty() ? 0 : intervals.front().first * MASK_WIDTH;
+	}
+
+	/**
+	 * @return the parametrization behind the word the set ends with, 0 for an empty set
+	 */
+	inline ParamNo getEnd() const {
+		return intervals.empty() ? 0 : intervals.back().last * MASK_WIDTH;
+	}
+
+	/**
+	 * @return number of the parametrizations in the set
+	 */
+	ParamNo size() const {
+		ParamNo count = 0;
+		for (const Interval & interval : intervals)
+			for (const size_t bit : crange(MASK_WIDTH))
+				count += ((interval.mask >> bit) & 1) * (interval.last - interval.first);
+		return count;
+	}
+
+	bool contains(const ParamNo param_no) const {
+		const ParamNo word = param_no / MASK_WIDTH;
+		auto next = upper_bound(intervals.begin(), intervals.end(), word, [](const ParamNo value, const Interval & interval) { return value < interval.first; });
+		return next != intervals.begin() && word < (next - 1)->last && (((next - 1)->mask >> (param_no % MASK_WIDTH)) & 1);
+	}
+
+	/**
+	 * Call visit(param_no) for each parametrization of the set in ascending order.
+	 */
+	template <class Visitor>
+	void forEach(Visitor && visit) const {
+		for (const Interval & interval : intervals)
+			for (const ParamNo word : crange(interval.first, interval.last))
+				for (const size_t bit : crange(MASK_WIDTH))
+					if ((interval.mask >> bit) & 1)
+						visit(word * MASK_WIDTH + bit);
+	}
+
+	bool operator==(const ParamSet & other) const {
+		return intervals == other.intervals;
+	}
+
+	static ParamSet intersect(const ParamSet & first, const ParamSet & second) {
+		return combine(first, second, [](const ParamMask a, const ParamMask b) { return a & b; }, true, true);
+	}
+
+	static ParamSet unite(const ParamSet & first, const ParamSet & second) {
+		return combine(first, second, [](const ParamMask a, const ParamMask b) { return a | b; }, false, false);
+	}
+
+	/**
+	 * @return parametrizations of the first set that are not in the second one
+	 */
+	static ParamSet subtract(const ParamSet & first, const ParamSet & second) {
+		return combine(first, second, [](const ParamMask a, const ParamMask b) { return a & ~b; }, true, false);
+	}
+};
+
+#endif // PARSYBONE_PARAM_SET_INCLUDED
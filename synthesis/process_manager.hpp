@@ -0,0 +1,344 @@
+/*
+ * Copyright (C) 2012-2013 - Adam Streck
+ * This file is a part of the ParSyBoNe (Parameter Synthetizer for Boolean Networks) verification tool.
+ * ParSyBoNe is a free software: you can redistribute it and/or modify it under the terms of the GNU General Public License version 3.
+ * ParSyBoNe is released without any warranty. See the GNU General Public License for more details. <http://www.gnu.org/licenses/>.
+ * For affiliations see <http://www.mi.fu-berlin.de/en/math/groups/dibimath> and <http://sybila.fi.muni.cz/>.
+ */
+
+#ifndef PARSYBONE_PROCESS_MANAGER_INCLUDED
+#define PARSYBONE_PROCESS_MANAGER_INCLUDED
+
+#include "parallel_manager.hpp"
+
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Coordinates worker processes forked on this machine, used for --dist 0 N.
+///
+/// The workers are forked once the product is built, so they share it with the coordinator. Each worker is connected by a Unix socket, over which it
+/// receives the rounds to compute (together with their members and the bound on the Cost) and sends back their results, a single line per round.
+/// The rounds are handed out in chunks of half of the remaining rounds divided between the workers. If a worker dies, the rounds it has not answered
+/// are handed out again and a new worker is forked instead of it.
+/// The results are passed to the caller in the order of the rounds, so that the output is the same as for a single process.
+/// If the bound is shared, it is kept in a memory mapped to all the workers, so that a Cost found by one of them bounds the others immediately.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class ProcessManager : public RoundSource {
+	/// A round sent to a worker together with its members.
+	typedef pair<RoundNo, ParamMask> Task;
+
+	struct Worker {
+		pid_t pid;
+		int socket; ///< The end of the socket owned by the coordinator.
+		string buffer; ///< Received data that do not form a whole line yet.
+		deque<Task> pending; ///< Rounds sent to the worker that have not been answered yet.
+		RoundNo rounds; ///< Rounds computed.
+		size_t chunks; ///< Chunks of rounds sent.
+		size_t restarts; ///< How many times the worker has died and has been forked again.
+	};
+
+	static const RoundNo MAX_CHUNK = 256; ///< Upper bound on the size of a chunk.
+	static const size_t MAX_ATTEMPTS = 3; ///< How many times a single round may be handed out before the computation is abandoned.
+
+	const ProductStructure & product;
+	const MembersFunc get_members;
+	const RoundFunc compute;
+	const RoundNo rounds_count; ///< Rounds are numbered from 1 to rounds_count.
+	const RoundNo window; ///< How far the workers may get ahead of the consumed round.
+	size_t bound; ///< The current bound on the Cost, sent with each round.
+	atomic<size_t> * shared_bound; ///< The bound in the memory shared with the workers, if it is shared.
+
+	RoundNo next_round; ///< The first round that has not been handed out yet.
+	RoundNo consumed; ///< The last round that has been consumed.
+	deque<Task> returned; ///< Rounds of the dead workers that have to be handed out again.
+	map<RoundNo, size_t> attempts; ///< How many times the returned rounds have been handed out.
+	map<RoundNo, RoundResults> results; ///< Received rounds that have not been consumed yet.
+	vector<Worker> workers;
+
+	/* Send the whole string, false if the other side has closed the socket. */
+	static bool sendAll(const int socket, const string & data) {
+		size_t sent = 0;
+		while (sent < data.size()) {
+			const ssize_t written = send(socket, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+			if (written < 0 && errno == EINTR)
+				continue;
+			if (written <= 0)
+				return false;
+			sent += written;
+		}
+		return true;
+	}
+
+	/* Receive whatever is available into the buffer, false if the other side has closed the socket. */
+	static bool receive(const int socket, string & buffer) {
+		char data[4096];
+		ssize_t received;
+		do {
+			received = read(socket, data, sizeof(data));
+		} while (received < 0 && errno == EINTR);
+		if (received <= 0)
+			return false;
+		buffer.append(data, received);
+		return true;
+	}
+
+	/* Remove the first whole line from the buffer, false if there is none. */
+	static bool popLine(string & buffer, string & line) {
+		const size_t end = buffer.find('\n');
+		if (end == buffer.npos)
+			return false;
+		line = buffer.substr(0, end);
+		buffer.erase(0, end + 1);
+		return true;
+	}
+
+	/* Body of a worker process - compute the rounds until the coordinator closes the socket. */
+	static void serve(const int socket, SynthesisManager & manager, const RoundFunc & compute) {
+		string buffer, line;
+		while (true) {
+			while (!popLine(buffer, line))
+				if (!receive(socket, buffer))
+					return;
+
+			istringstream request(line);
+			RoundNo round;
+			ParamMask members;
+			size_t bound;
+			request >> round >> members >> bound;
+			if (!sendAll(socket, serialize(round, compute(manager, round, members, bound))))
+				return;
+		}
+	}
+
+	/* Fork a new process for the worker. */
+	void startWorker(const size_t worker_no) {
+		int sockets[2];
+		if (socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) != 0)
+			throw runtime_error("Failed to create a socket for a worker process: " + string(strerror(errno)));
+
+		const pid_t pid = fork();
+		if (pid < 0) {
+			close(sockets[0]);
+			close(sockets[1]);
+			throw runtime_error("Failed to fork a worker process: " + string(strerror(errno)));
+		}
+		// The worker must not touch any of the resources of the coordinator, therefore it ends by _exit.
+		if (pid == 0) {
+			close(sockets[0]);
+			for (const Worker & worker : workers)
+				if (worker.socket >= 0)
+					close(worker.socket);
+			int status = 0;
+			try {
+				SynthesisManager manager(product);
+				manager.shareBound(shared_bound);
+				serve(sockets[1], manager, compute);
+			}
+			catch (...) {
+				status = 1;
+			}
+			_exit(status);
+		}
+
+		close(sockets[1]);
+		workers[worker_no].pid = pid;
+		workers[worker_no].socket = sockets[0];
+		workers[worker_no].buffer.clear();
+	}
+
+	/* The worker has died, hand its rounds over to the others and replace it. */
+	void restartWorker(const size_t worker_no) {
+		Worker & worker = workers[worker_no];
+		close(worker.socket);
+		worker.socket = -1;
+		waitpid(worker.pid, NULL, 0);
+
+		for (const Task & task : worker.pending)
+			if (++attempts[task.first] >= MAX_ATTEMPTS)
+				throw runtime_error("The round " + to_string(task.first) + " has been handed out " + to_string(MAX_ATTEMPTS) + " times without being computed.");
+		returned.insert(returned.end(), worker.pending.begin(), worker.pending.end());
+		sort(returned.begin(), returned.end());
+		worker.pending.clear();
+
+		worker.restarts++;
+		startWorker(worker_no);
+	}
+
+	/* Send a chunk of rounds to each of the workers that have nothing to do. */
+	void assignWork() {
+		for (const size_t worker_no : cscope(workers)) {
+			Worker & worker = workers[worker_no];
+			if (!worker.pending.empty())
+				continue;
+
+			if (!returned.empty()) {
+				worker.pending.push_back(returned.front());
+				returned.pop_front();
+			}
+			else {
+				const RoundNo last = min(rounds_count + 1, consumed + window + 1);
+				RoundNo chunk_size = (last - min(last, next_round)) / (2 * workers.size());
+				chunk_size = max(static_cast<RoundNo>(1), min(static_cast<RoundNo>(MAX_CHUNK), chunk_size));
+				for (; next_round < last && worker.pending.size() < chunk_size; next_round++)
+					worker.pending.push_back(make_pair(next_round, get_members(next_round)));
+				if (worker.pending.empty())
+					continue;
+			}
+
+			string requests;
+			for (const Task & task : worker.pending)
+				requests += to_string(task.first) + " " + to_string(task.second) + " " + to_string(bound) + "\n";
+			worker.chunks++;
+			if (!sendAll(worker.socket, requests))
+				restartWorker(worker_no);
+		}
+	}
+
+	/* Wait for some of the workers to answer and store their results. */
+	void collectResults() {
+		vector<pollfd> sockets;
+		for (const Worker & worker : workers)
+			sockets.push_back({ worker.socket, POLLIN, 0 });
+		if (poll(sockets.data(), sockets.size(), -1) < 0) {
+			if (errno == EINTR)
+				return;
+			throw runtime_error("Failed to wait for the worker processes: " + string(strerror(errno)));
+		}
+
+		for (const size_t worker_no : cscope(workers)) {
+			if (sockets[worker_no].revents == 0)
+				continue;
+			Worker & worker = workers[worker_no];
+			if (!receive(worker.socket, worker.buffer)) {
+				restartWorker(worker_no);
+				continue;
+			}
+
+			string line;
+			while (popLine(worker.buffer, line)) {
+				RoundNo round;
+				RoundResults round_results = deserialize(line, round);
+				worker.pending.erase(find_if(worker.pending.begin(), worker.pending.end(), [round](const Task & task) { return task.first == round; }));
+				worker.rounds++;
+				attempts.erase(round);
+				results.insert(make_pair(round, move(round_results)));
+			}
+		}
+	}
+
+public:
+	NO_COPY(ProcessManager)
+
+	/**
+	 * Fork the workers, each of them builds its own SynthesisManager over the product.
+	 * @param workers_count	number of the worker processes
+	 * @param _rounds_count	number of the rounds of this process
+	 * @param BFS_bound	the initial bound on the Cost
+	 * @param share_bound	if true, the workers check against the current bound and lower it by each Cost they find
+	 */
+	ProcessManager(const size_t workers_count, const ProductStructure & _product, const RoundNo _rounds_count, const size_t BFS_bound, const bool share_bound, MembersFunc _get_members, RoundFunc _compute)
+		: product(_product), get_members(move(_get_members)), compute(move(_compute)), rounds_count(_rounds_count), window(MAX_CHUNK * workers_count * 2),
+		bound(BFS_bound), shared_bound(nullptr), next_round(1), consumed(0), workers(workers_count, Worker{ -1, -1, "", deque<Task>(), 0, 0, 0 }) {
+		if (share_bound) {
+			void * memory = mmap(NULL, sizeof(atomic<size_t>), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+			if (memory == MAP_FAILED)
+				throw runtime_error("Failed to map the memory shared with the worker processes: " + string(strerror(errno)));
+			shared_bound = new (memory) atomic<size_t>(BFS_bound);
+		}
+		for (const size_t worker_no : crange(workers_count))
+			startWorker(worker_no);
+	}
+
+	/**
+	 * Closing the sockets makes the workers finish.
+	 */
+	~ProcessManager() {
+		for (Worker & worker : workers) {
+			if (worker.socket < 0)
+				continue;
+			close(worker.socket);
+			waitpid(worker.pid, NULL, 0);
+		}
+		if (shared_bound)
+			munmap(shared_bound, sizeof(atomic<size_t>));
+	}
+
+	/**
+	 * @return	the round as a single line of text
+	 */
+	static string serialize(const RoundNo round, const RoundResults & round_results) {
+		ostringstream line;
+		line.precision(numeric_limits<double>::max_digits10);
+		line << round << " " << round_results.bound << " " << round_results.members << " " << round_results.results.size();
+		for (const size_t member : cscope(round_results.results)) {
+			if (((round_results.members >> member) & 1) == 0)
+				continue;
+			const RoundResults::Member & result = round_results.results[member];
+			line << " " << result.cost << " " << result.block_cost << " " << result.block_depth << " " << result.robustness << " " << result.trans.size();
+			for (const StateTransition & trans : result.trans)
+				line << " " << trans.first << " " << trans.second;
+		}
+		line << "\n";
+		return line.str();
+	}
+
+	/**
+	 * @return	the round obtained from the line created by serialize
+	 */
+	static RoundResults deserialize(const string & line, RoundNo & round) {
+		istringstream data(line);
+		RoundResults round_results;
+		size_t round_size;
+		data >> round >> round_results.bound >> round_results.members >> round_size;
+		round_results.results.resize(round_size);
+		for (const size_t member : crange(round_size)) {
+			if (((round_results.members >> member) & 1) == 0)
+				continue;
+			RoundResults::Member & result = round_results.results[member];
+			size_t trans_count;
+			data >> result.cost >> result.block_cost >> result.block_depth >> result.robustness >> trans_count;
+			result.trans.resize(trans_count);
+			for (StateTransition & trans : result.trans)
+				data >> trans.first >> trans.second;
+		}
+		if (data.fail())
+			throw runtime_error("Malformed results received from a worker process: " + line);
+		return round_results;
+	}
+
+	void setBound(const size_t BFS_bound) override {
+		bound = BFS_bound;
+		if (shared_bound)
+			SynthesisManager::lowerBound(*shared_bound, BFS_bound);
+	}
+
+	RoundResults getRound(const RoundNo round) override {
+		while (results.count(round) == 0) {
+			assignWork();
+			collectResults();
+		}
+
+		auto result_it = results.find(round);
+		RoundResults round_results = move(result_it->second);
+		results.erase(result_it);
+		consumed = round;
+		return round_results;
+	}
+
+	string getLoadReport() override {
+		string rounds;
+		size_t chunks_count = 0, restarts_count = 0;
+		for (const Worker & worker : workers) {
+			rounds += (rounds.empty() ? "" : "/") + to_string(worker.rounds);
+			chunks_count += worker.chunks;
+			restarts_count += worker.restarts;
+		}
+		return "Processes load: rounds " + rounds + ", chunks " + to_string(chunks_count) + ", restarted workers " + to_string(restarts_count) + ".";
+	}
+};
+
+#endif // PARSYBONE_PROCESS_MANAGER_INCLUDED
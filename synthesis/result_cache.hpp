@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2012-2013 - Adam Streck
+ * This file is a part of the ParSyBoNe (Parameter Synthetizer for Boolean Networks) verification tool.
+ * ParSyBoNe is a free software: you can redistribute it and/or modify it under the terms of the GNU General Public License version 3.
+ * ParSyBoNe is released without any warranty. See the GNU General Public License for more details. <http://www.gnu.org/licenses/>.
+ * For affiliations see <http://www.mi.fu-berlin.de/en/math/groups/dibimath> and <http://sybila.fi.muni.cz/>.
+ */
+
+#ifndef PARSYBONE_RESULT_CACHE_INCLUDED
+#define PARSYBONE_RESULT_CACHE_INCLUDED
+
+#include "../auxiliary/common_functions.hpp"
+
+#include <unordered_map>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Costs of the checked parametrizations, each of them valid for all the parametrizations that agree on the contexts consulted by its check.
+///
+/// A check only reads the targets of the contexts of the transitions leaving the states it has reached. Any parametrization with the same targets
+/// of those contexts reaches the same states by the same levels and therefore has the same Cost under the same bound.
+/// The costs are grouped by the set of the consulted contexts, within a group they are hashed by the targets of its contexts.
+/// The number of the groups is limited, as each of them has to be searched, so is the number of the costs stored.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class ResultCache {
+	static const size_t MAX_GROUPS = 16; ///< Number of the distinct sets of the consulted contexts kept.
+	static const size_t MAX_ENTRIES = 1u << 20; ///< Number of the costs kept in all the groups together.
+
+	struct KeyHash {
+		size_t operator()(const Levels & key) const {
+			size_t hash = key.size();
+			for (const ActLevel value : key)
+				hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+			return hash;
+		}
+	};
+
+	/// Costs obtained by the checks that have consulted the same contexts under the same conditions.
+	struct Group {
+		vector<size_t> contexts; ///< Consulted contexts in ascending order.
+		vector<size_t> conditions; ///< Bound on the Cost and any other settings the costs depend on.
+		unordered_map<Levels, size_t, KeyHash> costs; ///< Cost for the targets of the contexts.
+	};
+
+	vector<Group> groups;
+	size_t entries_count;
+	size_t lookups_count; ///< Number of the parametrizations that were looked up.
+	size_t hits_count; ///< Number of the parametrizations whose Cost was found.
+	Levels key; ///< Buffer for the targets of the contexts of a group.
+
+	void project(const Levels & values, const vector<size_t> & contexts) {
+		key.resize(contexts.size());
+		for (const size_t context_no : cscope(contexts))
+			key[context_no] = values[contexts[context_no]];
+	}
+
+public:
+	ResultCache() : entries_count(0), lookups_count(0), hits_count(0) {}
+
+	/**
+	 * @param values	targets of all the contexts for the parametrization
+	 * @param conditions	bound on the Cost and any other settings the Cost depends on
+	 * @param[out] cost	the Cost, if found
+	 * @return true if the Cost of some parametrization that agrees on the contexts has been stored
+	 */
+	bool find(const Levels & values, const vector<size_t> & conditions, size_t & cost) {
+		lookups_count++;
+		for (auto group_it = groups.begin(); group_it != groups.end(); group_it++) {
+			const Group & group = *group_it;
+			if (group.conditions != conditions)
+				continue;
+			project(values, group.contexts);
+			auto known = group.costs.find(key);
+			if (known != group.costs.end()) {
+				cost = known->second;
+				hits_count++;
+				// The groups that are hit are searched first.
+				if (group_it != groups.begin())
+					iter_swap(group_it, group_it - 1);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * Store the Cost of the parametrization, unless the limits have been reached.
+	 * @param contexts	contexts consulted by the check in ascending order
+	 */
+	void add(const Levels & values, const vector<size_t> & contexts, const vector<size_t> & conditions, const size_t cost) {
+		// A check that has consulted all the contexts is valid only for the parametrization itself.
+		if (entries_count >= MAX_ENTRIES || contexts.size() == values.size())
+			return;
+		auto group = find_if(groups.begin(), groups.end(), [&](const Group & candidate) {
+			return candidate.conditions == conditions && candidate.contexts == contexts;
+		});
+		if (group == groups.end()) {
+			if (groups.size() >= MAX_GROUPS)
+				return;
+			groups.push_back({ contexts, conditions, {} });
+			group = groups.end() - 1;
+		}
+		project(values, contexts);
+		entries_count += group->costs.insert({ key, cost }).second;
+	}
+
+	/**
+	 * @return number of the costs that were found
+	 */
+	inline size_t getHitCount() const {
+		return hits_count;
+	}
+
+	/**
+	 * @return number of the parametrizations that were looked up
+	 */
+	inline size_t getLookupCount() const {
+		return lookups_count;
+	}
+
+	/**
+	 * @return the share of the lookups that have found the Cost as a line of text
+	 */
+	static string getHitReport(const size_t hits, const size_t lookups) {
+		const double rate = lookups > 0 ? 100. * hits / lookups : 0.;
+		return "Memoization: the Cost was reused for " + to_string(hits) + " of " + to_string(lookups) + " parametrizations (" + to_string(rate) + "%).";
+	}
+};
+
+#endif // PARSYBONE_RESULT_CACHE_INCLUDED
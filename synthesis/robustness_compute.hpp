@@ -22,11 +22,12 @@ class RobustnessCompute {
    const ProductStructure & product; ///< Product reference for state properties.
    const ColorStorage & storage; ///< Constant storage with the actuall data.
    CheckerSettings settings; ///< Setup for the process.
+   Levels context_values; ///< Targets of the contexts under the parametrization, decoded at the start of the computation.
 
    /// This structure holds values used in the iterative process of robustness computation.
-   vector<size_t> exits; ///< A number of transitions this state can be left through under given parametrization.
-   vector<double> current_prob; ///< Current probability of reaching.
-   vector<double> next_prob; ///< Will store the probability in the next round.
+   StampedVector<size_t> exits; ///< A number of transitions this state can be left through under given parametrization.
+   StampedVector<double> current_prob; ///< Current probability of reaching.
+   StampedVector<double> next_prob; ///< Will store the probability in the next round.
 
    /**
     * For each state compute how many exists are under each parametrization.
@@ -35,13 +36,13 @@ class RobustnessCompute {
       // If not acceptable, leave zero
       for (const StateTransition & tran : transitions) {
          // This one we've already counted
-         if (exits[tran.first] != 0)
+         if (exits.get(tran.first) != 0)
             continue;
 
-         const vector<StateID> transports = ColoringFunc::broadcastParameters(settings.getParamNo(), product.getStructure(), product.getKSID(tran.first));
+         const size_t transports = ColoringFunc::forEachSuccessor(context_values, product.getStructure(), product.getKSID(tran.first), [](const StateID) {});
 
          // If there are no transports, we have a loop - even if multiple loops are possible, consider only one.
-         exits[tran.first] = max(static_cast<size_t>(1), transports.size());
+         exits[tran.first] = max(static_cast<size_t>(1), transports);
       }
    }
 
@@ -49,9 +50,9 @@ class RobustnessCompute {
     * Set probability of each initial state to 1.0 / number of used initial states for this parametrization.
     */
    void initiate() {
-      exits.assign(exits.size(), 0);
-      current_prob.assign(current_prob.size(), 0.);
-      next_prob = current_prob;
+      exits.reset();
+      current_prob.reset();
+      next_prob.reset();
 
       setInitials();
    }
@@ -81,6 +82,7 @@ public:
     */
    void compute(const SynthesisResults & results, const vector<pair<StateID,StateID> > & transitions, const CheckerSettings & _settings) {
       settings = _settings;
+      ColoringFunc::decode(settings.getParamNo(), product.getStructure().getContexts(), context_values);
       initiate();
       computeExits(transitions);
 
@@ -89,16 +91,16 @@ public:
 
       // Cycle through the levels of the DFS procedure
       for (size_t round_num = 0; round_num < results.getUpperBound(); round_num++) {
-         // Copy the data from the previous round.
-         current_prob = next_prob;
-         next_prob.assign(next_prob.size(), 0.);
+         // Move the data from the previous round, only the states reached in it are cleared.
+         swap(current_prob, next_prob);
+         next_prob.reset();
 
          // For the parametrization cycle through transitions
          for (const auto & trans:transitions) {
-            size_t divisor = exits[trans.first]; // Count succesor
+            size_t divisor = exits.get(trans.first); // Count succesor
             // Add probabilities
             if (divisor)
-               next_prob[trans.second] += current_prob[trans.first] / divisor ;
+               next_prob[trans.second] += current_prob.get(trans.first) / divisor ;
          }
       }
    }
@@ -109,7 +111,7 @@ public:
    double getRobustness() const {
       double robustness = 0.;
       for (const StateID ID:settings.getFinals(product))
-         robustness += next_prob[ID];
+         robustness += next_prob.get(ID);
       return robustness;
    }
 
@@ -120,7 +122,7 @@ public:
       vector<double> markings;
       markings.reserve(settings.getFinals(product).size());
       for (const StateID ID:settings.getFinals(product))
-         markings.push_back(next_prob[ID]);
+         markings.push_back(next_prob.get(ID));
       return markings;
    }
 };
@@ -20,36 +20,79 @@
 class SplitManager {
    size_t processes_count; ///< How many processes are there alltogether.
    size_t process_number; ///< What is the number of the curren
+   size_t block_size; ///< How many consecutive parametrizations are computed within a single round.
    ParamNo all_colors_count; ///< All the parametrizations.
    ParamNo process_color_count; ///< Cut of all the parametrizations for this process.
    RoundNo rounds_count; ///< Number of rounds totally.
    RoundNo round_number; ///< Number of this round (starting from 0).
    ParamNo param_no; ///< Which parametrization is currently in use.
+   vector<ParamNo> gray_radices; ///< Numbers of the subcolors of the species from the most significant digit, empty if the plain order is used.
+   RoundNo gray_offset; ///< Position of the first round of this process in the Gray code.
+
+   /**
+    * Reflected mixed-radix Gray code - the lower digits run forth and back, their direction changes whenever a higher digit changes,
+    * which happens an odd number of times iff the number formed by the higher digits is odd.
+    * @return the parametrization at the position in the Gray code
+    */
+   ParamNo getGrayParamNo(ParamNo position) const {
+      ParamNo divisor = all_colors_count, result = 0;
+      bool reflected = false; ///< Is the current digit going backwards?
+      for (const ParamNo radix : gray_radices) {
+         divisor /= radix;
+         const ParamNo digit = position / divisor;
+         position %= divisor;
+         result += (reflected ? radix - 1 - digit : digit) * divisor;
+         // The prefix of the higher digits is odd iff it was odd and multiplied by an odd radix, or the digit is odd.
+         reflected = ((reflected && radix % 2 == 1) != (digit % 2 == 1));
+      }
+      return result;
+   }
 
 public:
    /**
     * @param processes_count	how many processes compute the coloring
     * @param process_number	index of this process
     * @param _all_colors_count	complete number of parameters that have to be tested by all the processes
+    * @param _block_size	number of consecutive parametrizations in a single round
     */
-   SplitManager(const size_t _processes_count, const size_t _process_number, const ParamNo _all_colors_count)
-      : processes_count(_processes_count), process_number(_process_number), all_colors_count(_all_colors_count) {
+   SplitManager(const size_t _processes_count, const size_t _process_number, const ParamNo _all_colors_count, const size_t _block_size = 1)
+      : processes_count(_processes_count), process_number(_process_number), block_size(_block_size), all_colors_count(_all_colors_count), gray_offset(0) {
+   }
+
+   /**
+    * Go through the parametrizations in the reflected mixed-radix Gray code, so that the successive parametrizations of the process differ
+    * in a single subcolor of a single specie, by a single step. Each process then checks a contiguous part of the code instead of every N-th round.
+    * Only for rounds of a single parametrization, to be called before computeSubspace.
+    * @param radices	numbers of the subcolors of all the species, the specie with the largest step_size first
+    */
+   void setGrayCode(const vector<ParamNo> & radices) {
+      if (block_size != 1)
+         throw invalid_argument("The Gray code order can only be used with rounds of a single parametrization.");
+      gray_radices = radices;
    }
 
    /**
     * This function computes index of the first parameter, size of a single round, number of rounds and other auxiliary data members used for splitting.
     */
    void computeSubspace() {
+      // Blocks are distributed between the processes, the last one may be incomplete
+      const RoundNo blocks_count = (all_colors_count + block_size - 1) / block_size;
+
       // Number of full rounds for all processes
-      rounds_count = all_colors_count / processes_count;
-      ParamNo rest_bits = all_colors_count % processes_count;
+      rounds_count = blocks_count / processes_count;
+      ParamNo rest_bits = blocks_count % processes_count;
 
       // If there is some leftover, add a round
       if (rest_bits >= process_number)
          rounds_count++;
 
       // Get colors num for this process
-      process_color_count = rounds_count;
+      process_color_count = rounds_count * block_size;
+      if (blocks_count > 0 && ((blocks_count - 1) % processes_count + 1) == process_number)
+         process_color_count -= blocks_count * block_size - all_colors_count;
+
+      // The processes before this one with an extra round are those with lower numbers.
+      gray_offset = (process_number - 1) * (blocks_count / processes_count) + min(static_cast<RoundNo>(process_number - 1), static_cast<RoundNo>(rest_bits));
 
       // Set positions for the round
       setStartPositions();
@@ -59,8 +102,8 @@ public:
     * Set values for the first round of computation.
     */
    void setStartPositions() {
-      param_no = process_number - 1;
       round_number = 1;
+      param_no = getParamNo(round_number);
    }
 
    /**
@@ -71,7 +114,7 @@ public:
       if (++round_number > rounds_count)
          return false;
 
-      param_no += processes_count;
+      param_no = getParamNo(round_number);
       return true;
    }
 
@@ -89,6 +132,33 @@ public:
       return param_no;
    }
 
+   /**
+    * @return	number of parametrizations to compute this round, starting with the one from getParamNo()
+    */
+   inline size_t getRoundSize() const {
+      return getRoundSize(param_no);
+   }
+
+   /**
+    * @param round	number of a round of this process (starting from 1)
+    * @return	the first parameter to compute in the given round
+    */
+   inline ParamNo getParamNo(const RoundNo round) const {
+      if (!gray_radices.empty())
+         return getGrayParamNo(gray_offset + round - 1);
+      return ((process_number - 1) + (round - 1) * processes_count) * block_size;
+   }
+
+   /**
+    * @param first	the first parameter of a round
+    * @return	number of parametrizations to compute in the round starting with first
+    */
+   inline size_t getRoundSize(const ParamNo first) const {
+      if (first >= all_colors_count)
+         return 0;
+      return static_cast<size_t>(min(static_cast<ParamNo>(block_size), all_colors_count - first));
+   }
+
    /**
     * @return	range with first and one before last parameter to compute for this process
     */
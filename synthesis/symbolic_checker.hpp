@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2012-2013 - Adam Streck
+ * This file is a part of the ParSyBoNe (Parameter Synthetizer for Boolean Networks) verification tool.
+ * ParSyBoNe is a free software: you can redistribute it and/or modify it under the terms of the GNU General Public License version 3.
+ * ParSyBoNe is released without any warranty. See the GNU General Public License for more details. <http://www.gnu.org/licenses/>.
+ * For affiliations see <http://www.mi.fu-berlin.de/en/math/groups/dibimath> and <http://sybila.fi.muni.cz/>.
+ */
+
+#ifndef PARSYBONE_SYMBOLIC_CHECKER_INCLUDED
+#define PARSYBONE_SYMBOLIC_CHECKER_INCLUDED
+
+#include "../auxiliary/stamped_vector.hpp"
+#include "../construction/product_structure.hpp"
+#include "../kinetics/kinetics.hpp"
+#include "decision_diagram.hpp"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Checks all the parametrizations at once, with the sets of parametrizations held in a decision diagram.
+///
+/// Each specie with more than a single subcolor is a level of the diagram whose digit is the number of the subcolor, weighted by the step_size of the specie,
+/// so that a set of the diagram is directly a set of the ParamNo values. A transition is open for a set of subcolors of a single specie, i.e. a literal of its level.
+/// The coloring is the same BFS as in the ModelChecker, only the states carry sets of parametrizations and each parametrization is spread
+/// only through the transitions open for it. The Cost of a parametrization is then derived from the levels at which the final states were reached,
+/// the same way as in the SynthesisManager.
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class SymbolicChecker {
+	typedef DecisionDiagram::Node Node;
+	/// A set of parametrizations that has reached a final state at the given level for the first time.
+	struct Found {
+		size_t level;
+		Node params;
+	};
+
+	const ProductStructure & product;
+	DecisionDiagram diagram;
+	vector<size_t> context_levels; ///< Level of the specie of each context, INF for a context with a single target.
+	map<tuple<size_t, bool, ActLevel>, Node> open_sets; ///< Parametrizations for which a transition with the context, direction and value is open.
+	vector<Node> stable_sets; ///< Parametrizations for which no transition leaves a KS state, INF if not computed yet.
+
+	StampedVector<Node> colors; ///< Parametrizations that have reached each state.
+	vector<Node> update_sets; ///< Parametrizations that the states in updates need to spread.
+	vector<Node> next_sets; ///< Parametrizations that the states in next_updates will need to spread.
+	vector<StateID> updates;
+	vector<StateID> next_updates;
+
+	static vector<ParamNo> getDomains(const Kinetics & kinetics) {
+		vector<ParamNo> domains;
+		for (const Kinetics::Specie & specie : kinetics.species)
+			if (specie.col_count > 1)
+				domains.push_back(specie.col_count);
+		return domains;
+	}
+
+	static vector<ParamNo> getWeights(const Kinetics & kinetics) {
+		vector<ParamNo> weights;
+		for (const Kinetics::Specie & specie : kinetics.species)
+			if (specie.col_count > 1)
+				weights.push_back(specie.step_size);
+		return weights;
+	}
+
+	Node getOpen(const TransConst & trans_const) {
+		const tuple<size_t, bool, ActLevel> key(trans_const.context, trans_const.req_dir, trans_const.comp_value);
+		auto known = open_sets.find(key);
+		if (known != open_sets.end())
+			return known->second;
+
+		const Levels & targets = product.getStructure().getContexts()[trans_const.context].targets;
+		vector<bool> values(targets.size());
+		for (const size_t value : cscope(targets))
+			values[value] = trans_const.req_dir ? targets[value] > trans_const.comp_value : targets[value] < trans_const.comp_value;
+		const Node open = context_levels[trans_const.context] == INF ? (values.front() ? DecisionDiagram::FULL : DecisionDiagram::EMPTY)
+			: diagram.makeLiteral(context_levels[trans_const.context], values);
+		open_sets.insert({ key, open });
+		return open;
+	}
+
+	Node getStable(const StateID KS_ID) {
+		if (stable_sets[KS_ID] == INF) {
+			Node leaving = DecisionDiagram::EMPTY;
+			for (const size_t trans_no : crange(product.getStructure().getTransitionCount(KS_ID)))
+				leaving = diagram.disjoin(leaving, getOpen(product.getStructure().getTransitionConst(KS_ID, trans_no)));
+			stable_sets[KS_ID] = diagram.subtract(DecisionDiagram::FULL, leaving);
+		}
+		return stable_sets[KS_ID];
+	}
+
+	/**
+	 * Add the parametrizations to the target and if there are new ones, schedule the target for an update in the next round.
+	 */
+	void schedule(const StateID ID, const Node params) {
+		const Node fresh = diagram.subtract(params, colors.get(ID));
+		if (fresh == DecisionDiagram::EMPTY)
+			return;
+		colors[ID] = diagram.disjoin(colors.get(ID), fresh);
+		if (next_sets[ID] == DecisionDiagram::EMPTY)
+			next_updates.push_back(ID);
+		next_sets[ID] = diagram.disjoin(next_sets[ID], fresh);
+	}
+
+	/**
+	 * The BFS from the initial states with the given parametrizations, the same as ModelChecker::conductIntervalCheck.
+	 * @param finals	final states to search for, all of them if empty
+	 * @param stop_found	if set, the parametrizations that have reached a final state do not continue
+	 * @return for each final state the parametrizations that have reached it, in the ascending order of the levels
+	 */
+	map<StateID, vector<Found> > reach(const vector<StateID> & initials, const Node params, const bool mark_initials, const vector<StateID> & finals,
+	                                   const size_t bound, const bool stop_found) {
+		map<StateID, vector<Found> > found;
+		colors.reset();
+		updates.clear();
+		for (const StateID init_ID : initials) {
+			if (mark_initials)
+				colors[init_ID] = params;
+			if (update_sets[init_ID] == DecisionDiagram::EMPTY)
+				updates.push_back(init_ID);
+			update_sets[init_ID] = params;
+		}
+		Node active = params; ///< Parametrizations that are still being spread.
+
+		for (size_t level = 0; !updates.empty(); level++) {
+			Node level_found = DecisionDiagram::EMPTY;
+			for (const StateID ID : updates) {
+				const Node update = diagram.conjoin(update_sets[ID], active);
+				update_sets[ID] = DecisionDiagram::EMPTY;
+				if (update == DecisionDiagram::EMPTY)
+					continue;
+
+				if (finals.empty() ? product.isFinal(ID) : find(finals.begin(), finals.end(), ID) != finals.end()) {
+					const Node colored = diagram.conjoin(update, colors.get(ID));
+					if (colored != DecisionDiagram::EMPTY) {
+						found[ID].push_back({ level, colored });
+						level_found = diagram.disjoin(level_found, colored);
+					}
+				}
+				if (level >= bound)
+					continue;
+
+				product.forEachTransition(ID, [&](const StateID target_ID, const TransConst & trans_const) {
+					schedule(target_ID, diagram.conjoin(update, getOpen(trans_const)));
+				});
+				if (product.getLoopCount(ID) > 0) {
+					const Node stable = diagram.conjoin(update, getStable(product.getKSID(ID)));
+					if (stable != DecisionDiagram::EMPTY)
+						product.forEachLoop(ID, [&](const StateID loop) { schedule(loop, stable); });
+				}
+			}
+			updates.clear();
+
+			if (stop_found)
+				active = diagram.subtract(active, level_found);
+			swap(updates, next_updates);
+			swap(update_sets, next_sets);
+		}
+
+		return found;
+	}
+
+public:
+	SymbolicChecker(const ProductStructure & _product, const Kinetics & kinetics)
+		: product(_product), diagram(getDomains(kinetics), getWeights(kinetics)), stable_sets(_product.getStructure().getStateCount(), INF),
+		colors(_product.getStateCount(), DecisionDiagram::EMPTY), update_sets(_product.getStateCount(), DecisionDiagram::EMPTY),
+		next_sets(_product.getStateCount(), DecisionDiagram::EMPTY) {
+		// A context belongs to the specie with the same step_size and number of subcolors, those with more than one have distinct step sizes.
+		const vector<ParamNo> domains = getDomains(kinetics), weights = getWeights(kinetics);
+		for (const TransContext & context : product.getStructure().getContexts()) {
+			context_levels.push_back(INF);
+			for (const size_t level : cscope(domains))
+				if (weights[level] == context.step_size && domains[level] == context.targets.size())
+					context_levels.back() = level;
+		}
+	}
+
+	/**
+	 * Conduct the coloring and the cycle detection for all the parametrizations at once.
+	 * @param bound	bound on the Cost
+	 * @return for each Cost, the parametrizations whose Cost it is
+	 */
+	vector<Node> computeCosts(const size_t bound) {
+		vector<Node> costs;
+		auto addCost = [&](const size_t cost, const Node params) {
+			if (costs.size() <= cost)
+				costs.resize(cost + 1, DecisionDiagram::EMPTY);
+			costs[cost] = diagram.disjoin(costs[cost], params);
+		};
+
+		const map<StateID, vector<Found> > reached = reach(product.getInitialStates(), DecisionDiagram::FULL, true, {}, bound, product.getMyType() == BA_finite);
+		for (const pair<const StateID, vector<Found> > & final : reached) {
+			// Reaching a final state is enough for a finite automaton, a standard one needs a cycle on it as well.
+			if (product.getMyType() == BA_finite) {
+				for (const Found & found : final.second)
+					addCost(found.level, found.params);
+				continue;
+			}
+
+			Node reaching = DecisionDiagram::EMPTY;
+			for (const Found & found : final.second)
+				reaching = diagram.disjoin(reaching, found.params);
+			const size_t cycle_bound = bound == INF ? INF : bound - final.second.front().level;
+			const map<StateID, vector<Found> > cycles = reach({ final.first }, reaching, false, { final.first }, cycle_bound, true);
+			if (cycles.empty())
+				continue;
+			for (const Found & found : final.second)
+				for (const Found & cycle : cycles.begin()->second)
+					if (bound == INF || found.level + cycle.level <= bound)
+						addCost(found.level + cycle.level, diagram.conjoin(found.params, cycle.params));
+		}
+
+		// Only the lowest Cost of a parametrization counts.
+		Node lower = DecisionDiagram::EMPTY;
+		for (Node & params : costs) {
+			const Node rest = diagram.subtract(params, lower);
+			lower = diagram.disjoin(lower, params);
+			params = rest;
+		}
+		return costs;
+	}
+
+	inline const DecisionDiagram & getDiagram() const {
+		return diagram;
+	}
+
+	inline DecisionDiagram & getDiagram() {
+		return diagram;
+	}
+};
+
+#endif // PARSYBONE_SYMBOLIC_CHECKER_INCLUDED
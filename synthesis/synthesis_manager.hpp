@@ -10,6 +10,7 @@
 #define PARSYBONE_SYNTHESIS_MANAGER_INCLUDED
 
 #include "../auxiliary/time_manager.hpp"
+#include "../auxiliary/user_options.hpp"
 
 #include "../model/model.hpp"
 #include "../model/property_automaton.hpp"
@@ -21,6 +22,7 @@
 #include "split_manager.hpp"
 #include "robustness_compute.hpp"
 #include "checker_setting.hpp"
+#include "result_cache.hpp"
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// \brief STEP 3 - Control class for the computation.
@@ -36,6 +38,32 @@ class SynthesisManager {
    unique_ptr<ColorStorage> storage; ///< Class that holds.
    unique_ptr<WitnessSearcher> searcher; ///< Class to build wintesses.
    unique_ptr<RobustnessCompute> computer; ///< Class to compute robustness.
+   AutType my_type; ///< Type of the automaton of the product, decides the verification procedure.
+   atomic<size_t> * shared_bound; ///< Bound on the Cost shared with the other workers, lowered by each Cost found, if any.
+   ParamNo space_size; ///< Number of all the parametrizations, the end of the last window of the interval checks.
+   // Window of the parametrizations that are checked at once by the interval check, the costs are kept for the rounds that follow.
+   ParamNo window_first; ///< First parametrization of the window.
+   ParamNo window_end; ///< Parametrization behind the last one of the window.
+   size_t window_bound; ///< Bound on the Cost under which the window has been checked.
+   vector<size_t> window_costs; ///< Cost found by the interval check for each parametrization of the window.
+   vector<size_t> window_depths; ///< Lowest bound under which the cost is valid for each parametrization of the window.
+   ResultCache cache; ///< Costs of the single parametrizations checked without the analysis.
+   bool guide_backward; ///< Are the checks of the finite properties guided by the backward reachability of the final states?
+
+   /**
+    * @return the bound lowered by the shared bound, if there is any
+    */
+   inline size_t getBound(const size_t BFS_bound) const {
+      return shared_bound ? min(BFS_bound, shared_bound->load(memory_order_relaxed)) : BFS_bound;
+   }
+
+   /**
+    * @brief publishCost lower the shared bound to the cost, if there is any
+    */
+   inline void publishCost(const size_t cost) {
+      if (shared_bound)
+         lowerBound(*shared_bound, cost);
+   }
 
    /**
     * @brief analyseLasso Parametrization is know to be satisfiable, make analysis of it.
@@ -76,7 +104,11 @@ class SynthesisManager {
       settings.minimize_cost = true;
       settings.param_no = param_no;
       settings.initial_states = settings.final_states = {final.first};
-      settings.bfs_bound = BFS_bound == INF ? BFS_bound : (BFS_bound - final.second);
+      // The shared bound may have dropped below the depth of the final state in between.
+      const size_t bound = getBound(BFS_bound);
+      if (bound < final.second)
+         return INF;
+      settings.bfs_bound = bound == INF ? bound : (bound - final.second);
 
       SynthesisResults results = model_checker->conductCheck(settings);
       const size_t cost = results.getLowerBound() == INF ? INF : results.getLowerBound() + final.second;
@@ -87,18 +119,66 @@ class SynthesisManager {
    }
 
 public:
-   SynthesisManager() {}
+   SynthesisManager() : my_type(BA_standard), shared_bound(nullptr), space_size(0), window_first(0), window_end(0), window_bound(0), guide_backward(false) {}
 
    /**
     * Constructor builds all the data objects that are used within.
     */
-   SynthesisManager(const ProductStructure & product)  {
+   SynthesisManager(const ProductStructure & product) : my_type(product.getMyType()), shared_bound(nullptr), space_size(1), window_first(0), window_end(0), window_bound(0),
+      guide_backward(false) {
+      // The context with the longest runs of the same value spans the whole space.
+      for (const TransContext & context : product.getStructure().getContexts())
+         space_size = max(space_size, context.step_size * context.targets.size());
       storage.reset(new ColorStorage(product));
       model_checker.reset(new ModelChecker(product, *storage));
       searcher.reset(new WitnessSearcher(product, *storage));
       computer.reset(new RobustnessCompute(product, *storage));
    }
 
+   /**
+    * @brief setBFSThreads split each level of a check of a single parametrization between the threads, including the caller
+    */
+   void setBFSThreads(const size_t threads_count) {
+      model_checker->setThreads(threads_count);
+   }
+
+   /**
+    * @brief setIncremental resume each check of a parametrization from the BFS of the previous one
+    */
+   void setIncremental(const bool incremental) {
+      model_checker->setIncremental(incremental);
+   }
+
+   /**
+    * @brief setBackwardGuidance let the checks of single parametrizations of a finite property enter only the states from which a final state can be reached
+    */
+   void setBackwardGuidance(const bool _guide_backward) {
+      guide_backward = _guide_backward;
+   }
+
+   /**
+    * @brief shareBound use the bound for all the following checks and lower it by each Cost found, only sound if the Cost is minimized
+    */
+   void shareBound(atomic<size_t> * _shared_bound) {
+      shared_bound = _shared_bound;
+   }
+
+   /**
+    * @brief lowerBound set the bound to the cost if the cost is lower, other threads or processes may be lowering it at the same time
+    */
+   static void lowerBound(atomic<size_t> & bound, const size_t cost) {
+      size_t current = bound.load(memory_order_relaxed);
+      while (cost < current && !bound.compare_exchange_weak(current, cost, memory_order_relaxed)) ;
+   }
+
+   /**
+    * @brief isBoundShareable the bound may be shared only if a parametrization that is accepted under a bound is accepted with the same Cost under any higher bound,
+    * which does not hold for counting of the accepting states, where the acceptance is decided by the number of the final states found within the bound.
+    */
+   static bool isBoundShareable(const UserOptions & user_options, const PropertyAutomaton & property) {
+      return user_options.minimalize_cost && !property.isCountingUsed();
+   }
+
    /**
     * @brief checkFull conduct model check with only reachability
     * @param[in] witnesses for all the shortest cycles
@@ -112,6 +192,7 @@ public:
    size_t checkFull(vector<StateTransition> & trans, double & robustness_val, const ParamNo param_no, const size_t BFS_bound, const bool witnesses, const bool robustness) {
       CheckerSettings settings;
       settings.bfs_bound = BFS_bound;
+      settings.shared_bound = shared_bound;
       settings.param_no = param_no;
       settings.mark_initals = true;
       SynthesisResults results = model_checker->conductCheck(settings);
@@ -153,9 +234,11 @@ public:
       CheckerSettings settings;
       settings.param_no = param_no;
       settings.bfs_bound = BFS_bound;
+      settings.shared_bound = shared_bound;
       settings.minimize_cost = true;
       settings.mark_initals = true;
 	  settings.minimal_count = min_acc;
+      settings.guide_backward = guide_backward;
       SynthesisResults results = model_checker->conductCheck(settings);
 
       if ((witnesses || robustness) && results.isAccepting(min_acc, max_acc)) {
@@ -169,6 +252,279 @@ public:
 
       return results.isAccepting(min_acc, max_acc) ? results.getLowerBound() : INF;
    }
+
+   /**
+    * @brief checkFullBlock block version of checkFull, conducts the check for all the members of the block at once
+    * @param[out] depths for each member, the lowest bound under which the cost of the parametrization is valid
+    * @param first number of the first parametrization of the block
+    * @param members mask of the parametrizations of the block to test
+    * @param BFS_bound current bound on depth
+    * @return the Cost value for each member, INF for the rest
+    */
+   vector<size_t> checkFullBlock(vector<size_t> & depths, const ParamNo first, const ParamMask members, const size_t BFS_bound) {
+      CheckerSettings settings;
+      settings.bfs_bound = BFS_bound;
+      settings.shared_bound = shared_bound;
+      settings.param_no = first;
+      settings.members = members;
+      settings.mark_initals = true;
+      const BlockResults results = model_checker->conductBlockCheck(settings);
+
+      // Test a bounded loop on each final state for all the parametrizations that have reached it within the same depth.
+      vector<size_t> costs(MASK_WIDTH, INF);
+      for (const BlockResults::Found & final : results.found) {
+         CheckerSettings cycle_settings;
+         cycle_settings.minimize_cost = true;
+         cycle_settings.param_no = first;
+         cycle_settings.members = final.mask;
+         cycle_settings.initial_states = cycle_settings.final_states = { final.ID };
+         const size_t bound = getBound(BFS_bound);
+         if (bound < final.depth)
+            continue;
+         cycle_settings.bfs_bound = bound == INF ? bound : (bound - final.depth);
+         const BlockResults cycles = model_checker->conductBlockCheck(cycle_settings);
+
+         for (const size_t bit : crange(MASK_WIDTH))
+            if (((final.mask >> bit) & 1) && cycles.isAccepting(bit, 1, INF))
+               costs[bit] = min(costs[bit], cycles.getLowerBound(bit) + final.depth);
+      }
+
+      // A lasso is found under a lower bound iff its whole length fits.
+      depths = costs;
+      return costs;
+   }
+
+   /**
+    * @brief checkFiniteBlock block version of checkFinite, conducts the check for all the members of the block at once
+    * @param[out] depths for each member, the lowest bound under which the cost of the parametrization is valid
+    * @param first number of the first parametrization of the block
+    * @param members mask of the parametrizations of the block to test
+    * @param BFS_bound current bound on depth
+    * @return the Cost value for each member, INF for the rest
+    */
+   vector<size_t> checkFiniteBlock(vector<size_t> & depths, const ParamNo first, const ParamMask members, const size_t BFS_bound, const size_t min_acc, const size_t max_acc) {
+      CheckerSettings settings;
+      settings.param_no = first;
+      settings.members = members;
+      settings.bfs_bound = BFS_bound;
+      settings.shared_bound = shared_bound;
+      settings.minimize_cost = true;
+      settings.mark_initals = true;
+      settings.minimal_count = min_acc;
+      const BlockResults results = model_checker->conductBlockCheck(settings);
+
+      // The search for an accepting parametrization stops at the depth of its last final state.
+      vector<size_t> costs(MASK_WIDTH, INF);
+      depths.assign(MASK_WIDTH, INF);
+      for (const size_t bit : crange(MASK_WIDTH)) {
+         if (((members >> bit) & 1) && results.isAccepting(bit, min_acc, max_acc)) {
+            costs[bit] = results.getLowerBound(bit);
+            depths[bit] = results.getUpperBound(bit);
+         }
+      }
+
+      return costs;
+   }
+
+   /**
+    * @brief checkFullInterval interval version of checkFullBlock, conducts the check for all the parametrizations [first, end) at once
+    * @param[out] depths for each parametrization, the lowest bound under which the cost of the parametrization is valid
+    * @return the Cost value for each parametrization
+    */
+   vector<size_t> checkFullInterval(vector<size_t> & depths, const ParamNo first, const ParamNo end, const size_t BFS_bound) {
+      CheckerSettings settings;
+      settings.bfs_bound = BFS_bound;
+      settings.shared_bound = shared_bound;
+      settings.params = ParamSet(first, end);
+      settings.mark_initals = true;
+      const IntervalResults results = model_checker->conductIntervalCheck(settings);
+
+      // Test a bounded loop on each final state for all the parametrizations that have reached it within the same depth.
+      vector<size_t> costs(static_cast<size_t>(end - first), INF);
+      for (const IntervalResults::Found & final : results.found) {
+         CheckerSettings cycle_settings;
+         cycle_settings.minimize_cost = true;
+         cycle_settings.params = final.params;
+         cycle_settings.initial_states = cycle_settings.final_states = { final.ID };
+         const size_t bound = getBound(BFS_bound);
+         if (bound < final.depth)
+            continue;
+         cycle_settings.bfs_bound = bound == INF ? bound : (bound - final.depth);
+         const IntervalResults cycles = model_checker->conductIntervalCheck(cycle_settings);
+
+         final.params.forEach([&](const ParamNo param_no) {
+            if (cycles.isAccepting(param_no, 1, INF))
+               costs[param_no - first] = min(costs[param_no - first], cycles.getLowerBound(param_no) + final.depth);
+         });
+      }
+
+      // A lasso is found under a lower bound iff its whole length fits.
+      depths = costs;
+      return costs;
+   }
+
+   /**
+    * @brief checkFiniteInterval interval version of checkFiniteBlock, conducts the check for all the parametrizations [first, end) at once
+    * @param[out] depths for each parametrization, the lowest bound under which the cost of the parametrization is valid
+    * @return the Cost value for each parametrization
+    */
+   vector<size_t> checkFiniteInterval(vector<size_t> & depths, const ParamNo first, const ParamNo end, const size_t BFS_bound, const size_t min_acc, const size_t max_acc) {
+      CheckerSettings settings;
+      settings.params = ParamSet(first, end);
+      settings.bfs_bound = BFS_bound;
+      settings.shared_bound = shared_bound;
+      settings.minimize_cost = true;
+      settings.mark_initals = true;
+      settings.minimal_count = min_acc;
+      const IntervalResults results = model_checker->conductIntervalCheck(settings);
+
+      // The search for an accepting parametrization stops at the depth of its last final state.
+      vector<size_t> costs(static_cast<size_t>(end - first), INF);
+      depths.assign(costs.size(), INF);
+      for (const ParamNo param_no : crange(first, end)) {
+         if (results.isAccepting(param_no, min_acc, max_acc)) {
+            costs[param_no - first] = results.getLowerBound(param_no);
+            depths[param_no - first] = results.getUpperBound(param_no);
+         }
+      }
+
+      return costs;
+   }
+
+   /**
+    * @brief checkWindow make sure the costs of the round are in the window, otherwise conduct the interval check of a new window that starts with the round
+    * @param window_size number of the parametrizations checked at once, at least the size of the round
+    */
+   void checkWindow(const ParamNo first, const size_t round_size, const size_t BFS_bound, const size_t window_size, const PropertyAutomaton & property) {
+      // The costs stay valid for any lower bound.
+      const size_t bound = getBound(BFS_bound);
+      if (first >= window_first && first + round_size <= window_end && bound <= window_bound)
+         return;
+
+      window_first = first;
+      window_end = max(first + round_size, min(first + window_size, space_size));
+      window_bound = bound;
+      if (my_type == BA_finite)
+         window_costs = checkFiniteInterval(window_depths, window_first, window_end, BFS_bound, property.getMinAcc(), property.getMaxAcc());
+      else
+         window_costs = checkFullInterval(window_depths, window_first, window_end, BFS_bound);
+   }
+
+   /**
+    * @brief checkType conduct the check of a single parametrization, based on the type of the property
+    * @return the Cost value for this parametrization
+    */
+   size_t checkType(vector<StateTransition> & trans, double & robustness_val, const ParamNo param_no, const size_t BFS_bound, const UserOptions & user_options, const PropertyAutomaton & property) {
+      switch (my_type) {
+      case BA_finite:
+         return checkFinite(trans, robustness_val, param_no, BFS_bound, user_options.compute_wintess, user_options.compute_robustness, property.getMinAcc(), property.getMaxAcc());
+      case BA_standard:
+         return checkFull(trans, robustness_val, param_no, BFS_bound, user_options.compute_wintess, user_options.compute_robustness);
+      default:
+         throw runtime_error("Unsupported Buchi automaton type.");
+      }
+   }
+
+   /**
+    * @return the costs stored for the parametrizations checked with memoization
+    */
+   inline const ResultCache & getCache() const {
+      return cache;
+   }
+
+   /**
+    * @brief check conduct the check of a single parametrization, the Cost is taken from the cache if some parametrization checked before
+    * agrees on all the contexts its check has consulted
+    * @return the Cost value for this parametrization
+    */
+   size_t check(vector<StateTransition> & trans, double & robustness_val, const ParamNo param_no, const size_t BFS_bound, const UserOptions & user_options, const PropertyAutomaton & property) {
+      // The analysis reads the transitions of the states it goes through, only the Cost alone is cached.
+      if (!user_options.use_memoization || user_options.analysis())
+         return checkType(trans, robustness_val, param_no, BFS_bound, user_options, property);
+
+      const vector<size_t> conditions = { getBound(BFS_bound), property.getMinAcc(), property.getMaxAcc() };
+      // The checks of the parametrization decode the same values again.
+      const Levels & values = model_checker->decodeValues(param_no);
+      size_t cost = INF;
+      if (cache.find(values, conditions, cost))
+         return cost;
+
+      model_checker->startConsulting();
+      cost = checkType(trans, robustness_val, param_no, BFS_bound, user_options, property);
+      const vector<size_t> contexts = model_checker->stopConsulting();
+      // If the shared bound has dropped during the check, the Cost is only valid under the new bound.
+      if (getBound(BFS_bound) == conditions.front())
+         cache.add(values, contexts, conditions, cost);
+      return cost;
+   }
+
+   /**
+    * @brief resolveMember obtain the Cost of a member of a round under the bound, the costs found by a block are valid as long as the bound does not drop below their depth
+    * @param[in,out] member	outcome of the parametrization, the block data are used if the block is used
+    */
+   void resolveMember(RoundResults::Member & member, const ParamNo param_no, const size_t BFS_bound, const UserOptions & user_options, const PropertyAutomaton & property) {
+      member.trans.clear();
+      member.robustness = 0.;
+
+      if (user_options.block_size > 1) {
+         member.cost = member.block_depth <= BFS_bound ? member.block_cost : INF;
+         // Analysis is only available for the single parametrization.
+         if (member.cost != INF && user_options.analysis())
+            member.cost = check(member.trans, member.robustness, param_no, BFS_bound, user_options, property);
+      }
+      else {
+         member.cost = check(member.trans, member.robustness, param_no, BFS_bound, user_options, property);
+      }
+   }
+
+   /**
+    * @brief checkRound conduct the check of all the members of a round, the whole block at once if the blocks are used
+    * @param first number of the first parametrization of the round
+    * @param round_size number of the parametrizations in the round
+    * @param members mask of the parametrizations of the round to test
+    * @param BFS_bound current bound on depth
+    */
+   RoundResults checkRound(const ParamNo first, const size_t round_size, const ParamMask members, const size_t BFS_bound, const UserOptions & user_options, const PropertyAutomaton & property) {
+      RoundResults round(getBound(BFS_bound), members, round_size);
+      setIncremental(user_options.use_incremental);
+      setBackwardGuidance(user_options.use_backward);
+
+      if (user_options.block_size > 1 && user_options.interval_size > 0) {
+         checkWindow(first, round_size, BFS_bound, user_options.interval_size, property);
+         for (const size_t member : crange(round_size)) {
+            round.results[member].block_cost = window_costs[first + member - window_first];
+            round.results[member].block_depth = window_depths[first + member - window_first];
+         }
+      }
+      else if (user_options.block_size > 1) {
+         vector<size_t> block_costs, block_depths;
+         if (my_type == BA_finite)
+            block_costs = checkFiniteBlock(block_depths, first, members, BFS_bound, property.getMinAcc(), property.getMaxAcc());
+         else
+            block_costs = checkFullBlock(block_depths, first, members, BFS_bound);
+         for (const size_t member : crange(round_size)) {
+            round.results[member].block_cost = block_costs[member];
+            round.results[member].block_depth = block_depths[member];
+         }
+      }
+
+      for (const size_t member : crange(round_size)) {
+         if ((members >> member) & 1) {
+            resolveMember(round.results[member], first + member, getBound(BFS_bound), user_options, property);
+            publishCost(round.results[member].cost);
+         }
+      }
+
+      // If the shared bound has dropped during the round, the results are only valid for the lowest bound.
+      if (shared_bound) {
+         round.bound = getBound(BFS_bound);
+         for (RoundResults::Member & result : round.results)
+            if (result.cost > round.bound)
+               result.cost = INF;
+      }
+
+      return round;
+   }
 };
 
 #endif // PARSYBONE_SYNTHESIS_MANAGER_INCLUDED
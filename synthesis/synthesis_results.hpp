@@ -9,7 +9,8 @@
 #ifndef SYNTHESIS_RESULTS_HPP
 #define SYNTHESIS_RESULTS_HPP
 
-#include "../auxiliary/data_types.hpp"
+#include "../auxiliary/common_functions.hpp"
+#include "param_set.hpp"
 
 struct SynthesisResults {
    map<StateID, size_t> found_depth; ///< when a final state was found
@@ -75,4 +76,152 @@ struct SynthesisResults {
    }
 };
 
+/// Results of a check conducted for a block of parametrizations at once. The i-th bit of a mask and the i-th value of a vector stand for the parametrization first + i.
+struct BlockResults {
+   /// A final state reached by some parametrizations of the block within the given depth.
+   struct Found {
+      StateID ID;
+      size_t depth;
+      ParamMask mask;
+   };
+   vector<Found> found; ///< All the final states that were found, each parametrization is present for the state at most once.
+   vector<size_t> counts; ///< Number of final states found for each parametrization.
+   vector<size_t> lower; ///< Lowest depth of a final state found for each parametrization.
+   vector<size_t> upper; ///< Highest depth of a final state found for each parametrization.
+
+   BlockResults() : counts(MASK_WIDTH, 0), lower(MASK_WIDTH, INF), upper(MASK_WIDTH, 0) {}
+
+   /**
+    * @brief add store the final state found by the parametrizations in the mask
+    */
+   void add(const StateID ID, const size_t depth, const ParamMask mask) {
+      found.push_back({ ID, depth, mask });
+      for (const size_t bit : crange(MASK_WIDTH)) {
+         if ((mask >> bit) & 1) {
+            counts[bit]++;
+            lower[bit] = min(lower[bit], depth);
+            upper[bit] = max(upper[bit], depth);
+         }
+      }
+   }
+
+   inline bool isAccepting(const size_t bit, const size_t min_acc, const size_t max_acc) const {
+      return (min_acc <= counts[bit]) && (max_acc >= counts[bit]);
+   }
+
+   /**
+    * @return mask of the parametrizations from the members that are accepting
+    */
+   ParamMask getAccepting(const ParamMask members, const size_t min_acc, const size_t max_acc) const {
+      ParamMask accepting = 0;
+      for (const size_t bit : crange(MASK_WIDTH))
+         if (((members >> bit) & 1) && isAccepting(bit, min_acc, max_acc))
+            accepting |= static_cast<ParamMask>(1) << bit;
+      return accepting;
+   }
+
+   /**
+    * @return the lowest cost of the parametrization or INF if none was found
+    */
+   inline size_t getLowerBound(const size_t bit) const {
+      return lower[bit];
+   }
+
+   /**
+    * @return the highest cost of the parametrization or INF if none was found
+    */
+   inline size_t getUpperBound(const size_t bit) const {
+      return counts[bit] == 0 ? INF : upper[bit];
+   }
+};
+
+/// Results of a check conducted for a set of parametrizations given by intervals, the same as BlockResults. The i-th value of a vector stands for the parametrization first + i.
+struct IntervalResults {
+   /// A final state reached by some parametrizations of the set within the given depth.
+   struct Found {
+      StateID ID;
+      size_t depth;
+      ParamSet params;
+   };
+   ParamNo first; ///< Lowest parametrization the results are kept for.
+   vector<Found> found; ///< All the final states that were found, each parametrization is present for the state at most once.
+   vector<size_t> counts; ///< Number of final states found for each parametrization.
+   vector<size_t> lower; ///< Lowest depth of a final state found for each parametrization.
+   vector<size_t> upper; ///< Highest depth of a final state found for each parametrization.
+
+   /**
+    * @param params_count	number of the parametrizations from first on the results are kept for
+    */
+   IntervalResults(const ParamNo _first = 0, const size_t params_count = 0) : first(_first), counts(params_count, 0), lower(params_count, INF), upper(params_count, 0) {}
+
+   /**
+    * @brief add store the final state found by the parametrizations in the set
+    */
+   void add(const StateID ID, const size_t depth, const ParamSet & params) {
+      params.forEach([this, depth](const ParamNo param_no) {
+         counts[param_no - first]++;
+         lower[param_no - first] = min(lower[param_no - first], depth);
+         upper[param_no - first] = max(upper[param_no - first], depth);
+      });
+      found.push_back({ ID, depth, params });
+   }
+
+   inline bool isAccepting(const ParamNo param_no, const size_t min_acc, const size_t max_acc) const {
+      return (min_acc <= counts[param_no - first]) && (max_acc >= counts[param_no - first]);
+   }
+
+   /**
+    * @return parametrizations from the set that are accepting
+    */
+   ParamSet getAccepting(const ParamSet & params, const size_t min_acc, const size_t max_acc) const {
+      ParamSet accepting;
+      ParamNo word = 0;
+      ParamMask mask = 0;
+      params.forEach([&](const ParamNo param_no) {
+         if (param_no / MASK_WIDTH != word) {
+            accepting.append(word, word + 1, mask);
+            word = param_no / MASK_WIDTH;
+            mask = 0;
+         }
+         if (isAccepting(param_no, min_acc, max_acc))
+            mask |= static_cast<ParamMask>(1) << (param_no % MASK_WIDTH);
+      });
+      accepting.append(word, word + 1, mask);
+      return accepting;
+   }
+
+   /**
+    * @return the lowest cost of the parametrization or INF if none was found
+    */
+   inline size_t getLowerBound(const ParamNo param_no) const {
+      return lower[param_no - first];
+   }
+
+   /**
+    * @return the highest cost of the parametrization or INF if none was found
+    */
+   inline size_t getUpperBound(const ParamNo param_no) const {
+      return counts[param_no - first] == 0 ? INF : upper[param_no - first];
+   }
+};
+
+/// Outcome of a whole round (a single parametrization or a block), computed under the given bound on the Cost. The i-th member stands for the parametrization first + i.
+struct RoundResults {
+   /// Outcome of a single parametrization of the round.
+   struct Member {
+      size_t cost; ///< Cost of the parametrization, INF if it is not accepting.
+      size_t block_cost; ///< For a block check, the Cost found by the block.
+      size_t block_depth; ///< For a block check, the lowest bound under which block_cost is valid.
+      double robustness;
+      vector<StateTransition> trans; ///< Witness transitions, if requested.
+
+      Member() : cost(INF), block_cost(INF), block_depth(INF), robustness(0.) {}
+   };
+   size_t bound; ///< Bound on the Cost that was used for the computation.
+   ParamMask members; ///< i-th bit set iff the i-th parametrization of the round was checked.
+   vector<Member> results; ///< Outcome for each parametrization of the round.
+
+   RoundResults(const size_t _bound = INF, const ParamMask _members = 0, const size_t round_size = 0) : bound(_bound), members(_members), results(round_size) {}
+};
+
 #endif // SYNTHESIS_RESULTS_HPP
@@ -26,6 +26,7 @@ class WitnessSearcher {
    const ProductStructure & product; ///< Product reference for state properties.
    const ColorStorage & storage; ///< Constant storage with the actuall data.
    CheckerSettings settings; ///< Setup for the process.
+   Levels context_values; ///< Targets of the contexts under the parametrization, decoded at the start of the computation.
 
    vector<StateTransition>  transitions; ///< Acutall storage of the transitions found - transitions are stored by parametrizations numbers in the form (source, traget).
 
@@ -37,7 +38,7 @@ class WitnessSearcher {
       size_t succeeded; ///< Mask of the parametrizations that are
       size_t busted; ///< Mask of the parametrizations that are guaranteed to not find a path in (Cost - depth) steps.
    };
-   vector<Marking> markings; ///< Actuall marking of the states.
+   StampedVector<Marking> markings; ///< Actuall marking of the states, only the states visited since the last reset hold a non-default marking.
 
    /**
     * Storest transitions in the form (source, target) within the transitions vector, for the path from the final vertex to the one in the current depth of the DFS procedure.
@@ -58,7 +59,8 @@ class WitnessSearcher {
     */
    size_t DFS(const StateID ID, const size_t depth, size_t last_branch) {
       // If this path is no use
-      if (markings[ID].busted <= depth && markings[ID].succeeded < depth)
+      const Marking & marking = markings.get(ID);
+      if (marking.busted <= depth && marking.succeeded < depth)
          return last_branch;
 
       // Store if the state is final or part of another path.
@@ -67,21 +69,18 @@ class WitnessSearcher {
       path[depth] = ID;
       if (settings.isFinal(ID, product) && depth != 0)
          storeTransitions(depth, last_branch);
-      else if (markings[ID].succeeded >= depth && markings[ID].succeeded > 0)
+      else if (markings.get(ID).succeeded >= depth && markings.get(ID).succeeded > 0)
          storeTransitions(depth, last_branch);
       // Continue with the DFS otherwise.
       else if (depth < max_depth){
-         vector<StateID> transports;
+         auto descend = [this, depth, &last_branch](const StateID succ) {
+            last_branch = min(DFS(succ, depth + 1, last_branch), depth); // Recursive descent with parametrizations passed from the predecessor.
+         };
 
-         if (ColoringFunc::broadcastParameters(settings.getParamNo(), product.getStructure(), product.getKSID(ID)).empty())
-            transports = product.getLoops(ID) ;
+         if (ColoringFunc::isStable(context_values, product.getStructure(), product.getKSID(ID)))
+            product.forEachLoop(ID, descend);
          else
-            transports = ColoringFunc::broadcastParameters(settings.getParamNo(), product, ID);
-
-
-         for (const StateID & succ: transports) {
-            last_branch = min(DFS(succ, depth + 1, last_branch), depth); // Recursive descent with parametrizations passed from the predecessor.
-         }
+            ColoringFunc::forEachSuccessor(context_values, product, ID, descend);
       }
       return last_branch;
    }
@@ -90,9 +89,8 @@ public:
    /**
     * Constructor ensures that data objects used within the whole computation process have appropriate size.
     */
-   WitnessSearcher(const ProductStructure & _product, const ColorStorage & _storage) : product(_product), storage(_storage) {
-      markings.resize(product.getStateCount());
-   }
+   WitnessSearcher(const ProductStructure & _product, const ColorStorage & _storage)
+      : product(_product), storage(_storage), markings(_product.getStateCount(), { 0u, INF }) { }
 
    /**
     * Function that executes the whole searching process
@@ -100,12 +98,13 @@ public:
    void findWitnesses(const SynthesisResults & results, const CheckerSettings & _settings) {
       // Preparation
       settings = _settings;
+      ColoringFunc::decode(settings.getParamNo(), product.getStructure().getContexts(), context_values);
       transitions.clear();
 
       // Search paths from all the final states
       for (const pair<size_t, size_t> depth : results.depths) {
 		 path = vector<StateID>(depth.first + 1, INF); // Currently needs one more space for the transition to a final state after the last measurement.
-		 markings.assign(markings.size(), { 0u, INF });
+		 markings.reset();
          max_depth = depth.first;
          auto inits = settings.getInitials(product);
          settings.final_states = results.getFinalsAtDepth(max_depth);
@@ -134,7 +133,7 @@ public:
          // Reformes based on the user request
          for (const StateTransition & trans:transitions){
             if (!use_long_witnesses) {
-               acceptable_paths.append(to_string(trans.first)).append(">").append(to_string(trans.second)).append(",");
+               acceptable_paths.append(to_string(product.getOriginalID(trans.first))).append(">").append(to_string(product.getOriginalID(trans.second))).append(",");
             } else {
                acceptable_paths.append(product.getString(trans.first)).append(">").append(product.getString(trans.second)).append(",");
             }
@@ -12,6 +12,7 @@
 #include <gtest/gtest.h>
 
 #include "../auxiliary/space_solver.hpp"
+#include "../parsing/constraint_evaluator.hpp"
 #include "../parsing/constraint_parser.hpp"
 
 /*TEST(ConstraintParserTest, TestCopy) {
@@ -65,6 +66,58 @@ TEST(ConstraintParserTest, CauseException) {
 	EXPECT_THROW(ConstraintParser::contains({ "A" }, 1, { 1 }, ")(A)("), runtime_error); // Parenthesis mismatch
 }
 
+TEST(ConstraintEvaluatorTest, EvaluateFormulae) {
+	std::string true_forms[] = { "tt", "A", "!B", "(ff|A)", "(A|B)", "!(A&B)", "(!(A&A)|!B)", "A|B|A", "((A))", " ( ff | \n A  ) ", "A & B = 0" };
+	for (auto & formula : true_forms)
+		EXPECT_TRUE(ConstraintEvaluator({ "A", "B" }, formula).evaluate({ 1, 0 })) << formula;
+
+	std::string false_forms[] = { "ff", "B", "((A|B)&ff)", "(B&!B)", "A&B&A", " \r  ((A |B ) & ff)" };
+	for (auto & formula : false_forms)
+		EXPECT_FALSE(ConstraintEvaluator({ "A", "B" }, formula).evaluate({ 1, 0 })) << formula;
+
+	std::string true_constrs[] = { "A != B" , "A > B & B <= C & C < 2", "(A=2)&(B=0)&(C=1)", "2 = A", "1 >= C" };
+	for (auto & formula : true_constrs)
+		EXPECT_TRUE(ConstraintEvaluator({ "A", "B", "C" }, formula).evaluate({ 2, 0, 1 })) << formula;
+
+	std::string false_constrs[] = { "A = C | A = B | B = C", "!(A > B)", "B = -1", "A > 2", "0 < B" };
+	for (auto & formula : false_constrs)
+		EXPECT_FALSE(ConstraintEvaluator({ "A", "B", "C" }, formula).evaluate({ 2, 0, 1 })) << formula;
+}
+
+TEST(ConstraintEvaluatorTest, CauseException) {
+	EXPECT_THROW(ConstraintEvaluator({ "A", "B" }, "C"), runtime_error); // No C defined
+	EXPECT_THROW(ConstraintEvaluator({ "A", "B" }, "A || B"), runtime_error); // Duplicate
+	EXPECT_THROW(ConstraintEvaluator({ "A", "B", "C" }, "A | B & C"), runtime_error); // Parenthesis ambiguity
+	EXPECT_THROW(ConstraintEvaluator({ "A", "B" }, "(((A | B) & A)"), runtime_error); // Parenthesis mismatch
+	EXPECT_THROW(ConstraintEvaluator({ "A" }, ")(A)("), runtime_error); // Parenthesis mismatch
+	EXPECT_THROW(ConstraintEvaluator({ "A" }, "1 = 1"), runtime_error); // No variable
+}
+
+TEST(ConstraintEvaluatorTest, MarkStates) {
+	// The states of the space [(0,1,0), (2,2,1)] that satisfy the formula, the first specie changing the fastest.
+	const Levels mins = { 0, 1, 0 }, maxes = { 2, 2, 1 };
+	vector<bool> marked(12, false);
+	ConstraintEvaluator({ "A", "B", "C" }, "A > B | (C & A = 0)").markStates(mins, maxes, marked);
+	EXPECT_EQ(vector<bool>({ false, false, true, false, false, false, true, false, true, true, false, false }), marked);
+
+	// Only the satisfying states are marked, the rest is kept.
+	ConstraintEvaluator({ "A", "B", "C" }, "B = 2 & A = 1").markStates(mins, maxes, marked);
+	EXPECT_EQ(vector<bool>({ false, false, true, false, true, false, true, false, true, true, true, false }), marked);
+
+	// The space spans several blocks of states evaluated at once, the last one incomplete.
+	const Levels big_mins = { 0, 1, 0 }, big_maxes = { 4, 5, 4 };
+	const ConstraintEvaluator evaluator({ "A", "B", "C" }, "(A < B & !(C = 2)) | A = 3 | (tt & B >= C)");
+	vector<bool> big_marked(125, false);
+	evaluator.markStates(big_mins, big_maxes, big_marked);
+	Levels levels(big_mins);
+	StateID ID = 0;
+	do {
+		EXPECT_EQ(evaluator.evaluate(levels), big_marked[ID]) << ID;
+		ID++;
+	} while (iterate(big_maxes, big_mins, levels));
+	EXPECT_EQ(125u, ID);
+}
+
 TEST(SpaceSolverTest, SolveSpace) {
 	SpaceSolver<ConstraintParser, ActLevel> solver{ new ConstraintParser(2, 1) };
 	solver->applyFormula({ "A", "B" }, "(B & A)");
@@ -64,8 +64,8 @@ TEST_F(StructureTest, TestCorrectUnparametrizedStucture) {
 	EXPECT_EQ(0, ust_com_tri.getStateLevels(0).front());
 	EXPECT_EQ(1, ust_com_tri.getStateLevels(3).back());
 	ASSERT_EQ(2, ust_com_tri.getTransitionCount(0)) << "Exactly two transitions should be possible from (0,0) ";
-	EXPECT_EQ(16, ust_com_tri.getTransitionConst(0, 0).step_size);
-	EXPECT_EQ(1, ust_com_tri.getTransitionConst(0, 1).step_size);
+	EXPECT_EQ(16, ust_com_tri.getContexts()[ust_com_tri.getTransitionConst(0, 0).context].step_size);
+	EXPECT_EQ(1, ust_com_tri.getContexts()[ust_com_tri.getTransitionConst(0, 1).context].step_size);
 }
 
 TEST_F(StructureTest, TestCorrectProduct) {
@@ -85,6 +85,38 @@ TEST_F(StructureTest, TestCorrectProduct) {
 	EXPECT_EQ(4, pro_cir_cyc.getFinalStates().size()) << "All possible TS states should have final version.";
 
 	ASSERT_EQ(2, pro_tri_tri.getStateCount());
+
+	for (const StateID ID : crange(pro_com_cyc.getStateCount())) {
+		const size_t trans_count = pro_com_cyc.getTransitionCount(ID);
+		const StateID KS_ID = pro_com_cyc.getKSID(ID);
+		EXPECT_TRUE(trans_count == 0 || trans_count % pro_com_cyc.getStructure().getTransitionCount(KS_ID) == 0) << "Product transitions are copies of the KS transitions.";
+		pro_com_cyc.forEachTransition(ID, [&](const StateID target_ID, const TransConst &) {
+			EXPECT_NE(KS_ID, pro_com_cyc.getKSID(target_ID)) << "A transition must change the KS state.";
+		});
+		pro_com_cyc.forEachLoop(ID, [&](const StateID loop) {
+			EXPECT_EQ(KS_ID, pro_com_cyc.getKSID(loop)) << "A loop must keep the KS state.";
+		});
+		EXPECT_EQ(trans_count + pro_com_cyc.getLoopCount(ID), pro_com_cyc.getOutDegree(ID)) << "Nothing is pruned.";
+	}
+}
+
+TEST_F(StructureTest, TestProductPredecessors) {
+	size_t trans_count = 0, loops_count = 0, preds_count = 0, loop_preds_count = 0;
+	for (const StateID ID : crange(pro_com_cyc.getStateCount())) {
+		pro_com_cyc.forEachTransition(ID, [&](const StateID target_ID, const TransConst &) {
+			EXPECT_TRUE(pro_com_cyc.anyPredecessor(target_ID, [ID](const StateID source_ID, const TransConst &) { return source_ID == ID; })) << "Each transition must be found at its target.";
+		});
+		pro_com_cyc.forEachLoop(ID, [&](const StateID loop) {
+			EXPECT_TRUE(pro_com_cyc.anyLoopPredecessor(loop, [ID](const StateID source_ID) { return source_ID == ID; })) << "Each loop must be found at its target.";
+		});
+		trans_count += pro_com_cyc.getTransitionCount(ID);
+		loops_count += pro_com_cyc.getLoopCount(ID);
+		pro_com_cyc.forEachPredecessor(ID, [&](const StateID, const TransConst &) { preds_count++; });
+		pro_com_cyc.forEachLoopPredecessor(ID, [&](const StateID) { loop_preds_count++; });
+	}
+	EXPECT_EQ(trans_count, preds_count);
+	EXPECT_EQ(loops_count, loop_preds_count);
+	EXPECT_EQ(trans_count + loops_count, pro_com_cyc.getPredecessorCount());
 }
 
 #endif // CONSTRUCTION_TEST_H
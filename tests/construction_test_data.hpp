@@ -22,6 +22,7 @@ protected:
 	ProductStructure pro_com_cyc;
 	ProductStructure pro_com_sta;
 	ProductStructure pro_com_top;
+	ProductStructure pro_com_two;
 	ProductStructure pro_com_tri;
 	ProductStructure pro_mul_cyc;
 	ProductStructure pro_mul_mul;
@@ -38,6 +39,7 @@ protected:
 		pro_com_cyc = ConstructionManager::construct(mod_com, ltl_cyc, kin_com_cyc);
 		pro_com_sta = ConstructionManager::construct(mod_com, ltl_sta, kin_com_sta);
 		pro_com_top = ConstructionManager::construct(mod_com, ltl_top, kin_com_top);
+		pro_com_two = ConstructionManager::construct(mod_com, ltl_two, kin_com_two);
 		pro_com_tri = ConstructionManager::construct(mod_com, ltl_tri, kin_com_tri);
 		pro_mul_mul = ConstructionManager::construct(mod_mul, ltl_mul, kin_mul_mul);
 		pro_mul_cyc = ConstructionManager::construct(mod_mul, ltl_cyc, kin_mul_cyc);
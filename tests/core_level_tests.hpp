@@ -10,6 +10,7 @@
 
 #include <gtest/gtest.h>
 #include "../synthesis/split_manager.hpp"
+#include "../auxiliary/stamped_vector.hpp"
 
 TEST(CoreLevelTest, SplitTest) {
    SplitManager manager(3,1,10);
@@ -20,4 +21,83 @@ TEST(CoreLevelTest, SplitTest) {
       ASSERT_GT(10u, param_no);
       param_no += 3;
    } while(manager.increaseRound());
-}
\ No newline at end of file
+}
+
+TEST(CoreLevelTest, SplitBlockTest) {
+   // 10 parametrizations in blocks of 4 split between 2 processes: the second process gets [4,8[ only.
+   SplitManager first(2,1,10,4), second(2,2,10,4);
+   first.computeSubspace();
+   second.computeSubspace();
+   EXPECT_EQ(6u, first.getProcColorsCount());
+   EXPECT_EQ(4u, second.getProcColorsCount());
+
+   EXPECT_EQ(0u, first.getParamNo());
+   EXPECT_EQ(4u, first.getRoundSize());
+   ASSERT_TRUE(first.increaseRound());
+   EXPECT_EQ(8u, first.getParamNo());
+   EXPECT_EQ(2u, first.getRoundSize());
+   EXPECT_FALSE(first.increaseRound());
+
+   EXPECT_EQ(4u, second.getParamNo());
+   EXPECT_EQ(4u, second.getRoundSize());
+   EXPECT_FALSE(second.increaseRound());
+}
+
+TEST(CoreLevelTest, SplitRoundAccessTest) {
+   // Any round can be accessed directly, which is how the rounds are handed to the threads.
+   SplitManager manager(2,2,21,4);
+   manager.computeSubspace();
+   do {
+      EXPECT_EQ(manager.getParamNo(), manager.getParamNo(manager.getRoundNo()));
+      EXPECT_EQ(manager.getRoundSize(), manager.getRoundSize(manager.getParamNo()));
+   } while(manager.increaseRound());
+   EXPECT_EQ(1u, manager.getRoundSize(20));
+}
+
+TEST(CoreLevelTest, SplitGrayTest) {
+   // Radices 3, 2, 2 give 12 parametrizations, split between 5 processes as 3, 3, 2, 2, 2.
+   const vector<ParamNo> radices = { 3, 2, 2 };
+   set<ParamNo> visited;
+   ParamNo last = INF;
+   for (const size_t process : crange(1u, 6u)) {
+      SplitManager manager(5, process, 12);
+      manager.setGrayCode(radices);
+      manager.computeSubspace();
+      EXPECT_EQ(process <= 2 ? 3u : 2u, manager.getRoundCount());
+      do {
+         const ParamNo param_no = manager.getParamNo();
+         EXPECT_EQ(param_no, manager.getParamNo(manager.getRoundNo()));
+         EXPECT_TRUE(visited.insert(param_no).second);
+         // The processes together go through the code, each step changes a single digit by one.
+         if (last != INF) {
+            size_t changed = 0;
+            for (const ParamNo divisor : { 4u, 2u, 1u }) {
+               const ParamNo before = (last / divisor) % (divisor == 4u ? 3u : 2u), after = (param_no / divisor) % (divisor == 4u ? 3u : 2u);
+               changed += before != after;
+               EXPECT_GE(1u, max(before, after) - min(before, after));
+            }
+            EXPECT_EQ(1u, changed);
+         }
+         last = param_no;
+      } while(manager.increaseRound());
+   }
+   EXPECT_EQ(12u, visited.size());
+   EXPECT_THROW(SplitManager(1, 1, 12, 4).setGrayCode(radices), invalid_argument);
+}
+
+TEST(CoreLevelTest, StampedVectorTest) {
+   StampedVector<size_t> values(3, 7);
+   EXPECT_EQ(7u, values.get(1));
+   values[1] += 2;
+   EXPECT_TRUE(values.isSet(1));
+   EXPECT_FALSE(values.isSet(0));
+   EXPECT_EQ(9u, values.get(1));
+   EXPECT_FALSE(values.touch(1));
+
+   // The reset only starts a new epoch, the old values are not visible anymore.
+   values.reset();
+   EXPECT_FALSE(values.isSet(1));
+   EXPECT_EQ(7u, values.get(1));
+   EXPECT_TRUE(values.touch(1));
+   EXPECT_EQ(7u, values.get(1));
+}
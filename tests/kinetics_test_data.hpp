@@ -15,6 +15,7 @@ protected:
 	Kinetics kin_com_cyc;
 	Kinetics kin_com_sta;
 	Kinetics kin_com_top;
+	Kinetics kin_com_two;
 	Kinetics kin_com_tri;
 	Kinetics kin_mul_cyc;
 	Kinetics kin_mul_mul;
@@ -31,6 +32,7 @@ protected:
 		kin_com_cyc = ConstructionManager::computeKinetics(mod_com, ltl_cyc);
 		kin_com_sta = ConstructionManager::computeKinetics(mod_com, ltl_sta);
 		kin_com_top = ConstructionManager::computeKinetics(mod_com, ltl_top);
+		kin_com_two = ConstructionManager::computeKinetics(mod_com, ltl_two);
 		kin_com_tri = ConstructionManager::computeKinetics(mod_com, ltl_tri);
 		kin_mul_cyc = ConstructionManager::computeKinetics(mod_mul, ltl_cyc);
 		kin_mul_mul = ConstructionManager::computeKinetics(mod_mul, ltl_mul);
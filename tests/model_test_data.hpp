@@ -31,6 +31,7 @@ protected:
    PropertyAutomaton ltl_top; //< Have a peak either on A or on B
    PropertyAutomaton ltl_sta; //< Stable state
    PropertyAutomaton ltl_bst; //< Bistable prop
+   PropertyAutomaton ltl_two; //< Set two ones and reach two states afterwards
    PropertyAutomaton ltl_exp; //< Series with experiment
 
    void setUpModels() {
@@ -127,6 +128,16 @@ protected:
       ltl_bst.addEdge(1,2,{"tt",false, true});
       ltl_bst.addEdge(2,2,{"ff"});
 
+      ltl_two = PropertyAutomaton(TimeSeries);
+      ltl_two.min_acc = 2;
+      ltl_two.addState("ser0", false);
+      ltl_two.addState("ser1", false);
+      ltl_two.addState("ser2", true);
+      ltl_two.addEdge(0,1,{"(A=0&B=1)"});
+      ltl_two.addEdge(1,1,{"tt"});
+      ltl_two.addEdge(1,2,{"(A=1&B=1)"});
+      ltl_two.addEdge(2,2,{"tt"});
+
 	  ltl_exp = PropertyAutomaton(TimeSeries);
 	  ltl_exp.addState("ser0", false);
 	  ltl_exp.addState("ser1", false);
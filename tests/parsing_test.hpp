@@ -34,6 +34,46 @@ TEST_F(ParsingTest, ParseArguments) {
    EXPECT_STREQ(source_path.c_str(), user_options.property_path.c_str());
 }
 
+TEST_F(ParsingTest, ParseThreads) {
+   UserOptions user_options;
+   EXPECT_FALSE(user_options.plan_parallel);
+   string model = (source_path + example_model + MODEL_SUFFIX);
+   string property = (source_path + example_automaton + PROPERTY_SUFFIX);
+   const char * argv [] = {"program_name",
+                           model.c_str(),
+                           property.c_str(),
+                           "--threads",
+                           "auto",
+                           "--bfs-threads",
+                           "2"};
+   // The planner chooses the BFS splitting by itself.
+   EXPECT_THROW(ParsingManager::parseOptions(sizeof(argv)/sizeof(char*), argv), runtime_error);
+   EXPECT_NO_THROW(user_options = ParsingManager::parseOptions(sizeof(argv)/sizeof(char*) - 2, argv));
+   EXPECT_TRUE(user_options.plan_parallel);
+   EXPECT_EQ(1, user_options.threads_count);
+   argv[3] = "--bound";
+   argv[4] = "5";
+   EXPECT_NO_THROW(user_options = ParsingManager::parseOptions(sizeof(argv)/sizeof(char*), argv));
+   EXPECT_FALSE(user_options.plan_parallel);
+   EXPECT_EQ(2, user_options.bfs_threads_count);
+}
+
+TEST_F(ParsingTest, RejectGrayWithFilter) {
+   // The filter reads its database only forwards, the Gray code does not visit the parametrizations in the ascending order.
+   const string filter = "gray_filter" + DATABASE_SUFFIX;
+   ofstream(filter.c_str()).close();
+   string model = (source_path + example_model + MODEL_SUFFIX);
+   string property = (source_path + example_automaton + PROPERTY_SUFFIX);
+   const char * argv [] = {"program_name",
+                           model.c_str(),
+                           property.c_str(),
+                           filter.c_str(),
+                           "--gray"};
+   EXPECT_THROW(ParsingManager::parseOptions(sizeof(argv)/sizeof(char*), argv), runtime_error);
+   EXPECT_NO_THROW(ParsingManager::parseOptions(sizeof(argv)/sizeof(char*) - 1, argv));
+   remove(filter.c_str());
+}
+
 TEST_F(ParsingTest, ParseExamples) {
    Model example_m;
    EXPECT_NO_THROW(example_m = ParsingManager::parseModel(source_path, example_model));
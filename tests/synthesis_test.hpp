@@ -18,6 +18,400 @@ bool containsTrans(const string & witness, const vector<string> & trans ) {
    return true;
 }
 
+/// Outcome of the check of a single parametrization.
+struct CheckOutcome {
+   size_t cost;
+   vector<StateTransition> witness;
+   double robustness;
+};
+
+/**
+ * Compare the checker under test with the checks of the single parametrizations by the manager of each case.
+ * @param analysis	if true, the witnesses and the robustness are compared as well
+ * @param check	the checker under test, gives the outcomes of all the parametrizations of the case in the order of their numbers, possibly several times over
+ */
+template <class Checker>
+void compareWithSingle(const vector<CheckCase> & cases, const bool analysis, Checker check) {
+   UserOptions options;
+   options.compute_wintess = options.compute_robustness = analysis;
+   for (const CheckCase & check_case : cases) {
+      const ParamNo space = KineticsTranslators::getSpaceSize(check_case.kinetics);
+      vector<CheckOutcome> expected(space);
+      for (const ParamNo param_no : crange(space)) {
+         CheckOutcome & outcome = expected[param_no];
+         outcome.robustness = 0.;
+         outcome.cost = check_case.manager.check(outcome.witness, outcome.robustness, param_no, check_case.bound, options, check_case.property);
+      }
+
+      const vector<CheckOutcome> outcomes = check(check_case, options);
+      ASSERT_EQ(0u, outcomes.size() % space);
+      for (const size_t outcome_no : cscope(outcomes)) {
+         const CheckOutcome & reference = expected[outcome_no % space];
+         EXPECT_EQ(reference.cost, outcomes[outcome_no].cost) << "Parametrization " << outcome_no % space << " under the bound " << check_case.bound;
+         if (!analysis)
+            continue;
+         EXPECT_EQ(reference.witness, outcomes[outcome_no].witness) << "Parametrization " << outcome_no % space;
+         EXPECT_DOUBLE_EQ(reference.robustness, outcomes[outcome_no].robustness) << "Parametrization " << outcome_no % space;
+      }
+   }
+}
+
+TEST(ColoringTest, OpenMaskMatchesSingle) {
+   const Levels targets = { 0, 2, 1, 2, 0 };
+   for (const ParamNo step_size : { 1ull, 3ull, 7ull, 64ull, 100ull }) {
+      const vector<TransContext> contexts = { { step_size, targets } };
+      for (const bool dir : { true, false }) {
+         const TransConst trans_const = { 0, dir, 1 };
+         for (const ParamNo first : { 0ull, 5ull, 63ull, 64ull, 1000ull }) {
+            const ParamMask mask = ColoringFunc::openMask(first, contexts[0], trans_const);
+            for (const size_t bit : crange(MASK_WIDTH)) {
+               Levels values;
+               ColoringFunc::decode(first + bit, contexts, values);
+               EXPECT_EQ(ColoringFunc::isOpen(values, trans_const), ((mask >> bit) & 1) == 1) << step_size << " " << first << " " << bit;
+            }
+            EXPECT_EQ(mask & 0x7full, ColoringFunc::openMask(first, contexts[0], trans_const, 7));
+         }
+      }
+   }
+}
+
+TEST(ColoringTest, ParamSetOperations) {
+   // Sets given as masks over the parametrizations [0, 300).
+   auto fromBits = [](const vector<bool> & bits) {
+      ParamSet params;
+      for (const size_t word : crange((bits.size() + MASK_WIDTH - 1) / MASK_WIDTH)) {
+         ParamMask mask = 0;
+         for (const size_t bit : crange(MASK_WIDTH))
+            if (word * MASK_WIDTH + bit < bits.size() && bits[word * MASK_WIDTH + bit])
+               mask |= static_cast<ParamMask>(1) << bit;
+         params.append(word, word + 1, mask);
+      }
+      return params;
+   };
+   vector<bool> first(300), second(300);
+   for (const size_t param_no : crange(300u)) {
+      first[param_no] = param_no % 3 == 0 || (param_no > 100 && param_no < 250);
+      second[param_no] = param_no % 2 == 0 && param_no > 50;
+   }
+   const ParamSet first_set = fromBits(first), second_set = fromBits(second);
+   vector<bool> both(300), either(300), rest(300);
+   for (const size_t param_no : crange(300u)) {
+      both[param_no] = first[param_no] && second[param_no];
+      either[param_no] = first[param_no] || second[param_no];
+      rest[param_no] = first[param_no] && !second[param_no];
+      EXPECT_EQ(first[param_no], first_set.contains(param_no));
+   }
+   EXPECT_EQ(fromBits(both), ParamSet::intersect(first_set, second_set));
+   EXPECT_EQ(fromBits(either), ParamSet::unite(first_set, second_set));
+   EXPECT_EQ(fromBits(rest), ParamSet::subtract(first_set, second_set));
+   EXPECT_EQ(static_cast<ParamNo>(count(first.begin(), first.end(), true)), first_set.size());
+
+   // Full words in between are joined to a single interval.
+   const ParamSet range(10, 1000);
+   EXPECT_EQ(3u, range.getIntervals().size());
+   EXPECT_EQ(990u, range.size());
+   EXPECT_TRUE(ParamSet::subtract(range, ParamSet(0, 2000)).empty());
+}
+
+TEST(ColoringTest, OpenSetMatchesSingle) {
+   const Levels targets = { 0, 2, 1, 2, 0 };
+   for (const ParamNo step_size : { 1ull, 3ull, 7ull, 64ull, 100ull, 1000ull }) {
+      const vector<TransContext> contexts = { { step_size, targets } };
+      for (const bool dir : { true, false }) {
+         const TransConst trans_const = { 0, dir, 1 };
+         const ParamSet params = ParamSet::subtract(ParamSet(5, 20000), ParamSet(130, 4000));
+         const ParamSet open = ColoringFunc::openSet(params, contexts[0], trans_const);
+         for (const ParamNo param_no : crange(0ull, 20100ull)) {
+            Levels values;
+            ColoringFunc::decode(param_no, contexts, values);
+            ASSERT_EQ(params.contains(param_no) && ColoringFunc::isOpen(values, trans_const), open.contains(param_no)) << step_size << " " << param_no;
+         }
+      }
+   }
+   // A context whose period divides MASK_WIDTH repeats the same mask in all the words.
+   const Levels binary = { 0, 1 };
+   const vector<TransContext> contexts = { { 4ull, binary } };
+   EXPECT_EQ(1u, ColoringFunc::openSet(ParamSet(0, 64000), contexts[0], { 0, true, 0 }).getIntervals().size());
+}
+
+TEST(ColoringTest, DecisionDiagramOperations) {
+   // Three digits with 2, 3 and 4 values, the first one is the most significant.
+   DecisionDiagram diagram({ 2, 3, 4 }, { 12, 4, 1 });
+   const DecisionDiagram::Node first = diagram.makeLiteral(0, { false, true });
+   const DecisionDiagram::Node third = diagram.makeLiteral(2, { true, false, true, false });
+   const DecisionDiagram::Node both = diagram.conjoin(first, third), either = diagram.disjoin(first, third), rest = diagram.subtract(first, third);
+
+   vector<ParamNo> listed;
+   diagram.forEach(either, [&listed](const ParamNo number) { listed.push_back(number); });
+   EXPECT_TRUE(is_sorted(listed.begin(), listed.end()));
+   ParamNo both_count = 0, either_count = 0, rest_count = 0;
+   for (const ParamNo number : crange(24ull)) {
+      const bool in_first = number >= 12, in_third = number % 2 == 0;
+      EXPECT_EQ(in_first && in_third, diagram.contains(both, number));
+      EXPECT_EQ(in_first || in_third, diagram.contains(either, number));
+      EXPECT_EQ(in_first && !in_third, diagram.contains(rest, number));
+      EXPECT_EQ(in_first || in_third, find(listed.begin(), listed.end(), number) != listed.end());
+      both_count += in_first && in_third; either_count += in_first || in_third; rest_count += in_first && !in_third;
+   }
+   EXPECT_EQ(both_count, diagram.count(both));
+   EXPECT_EQ(either_count, diagram.count(either));
+   EXPECT_EQ(rest_count, diagram.count(rest));
+   EXPECT_EQ(24u, diagram.count(DecisionDiagram::FULL));
+   EXPECT_EQ(first, diagram.disjoin(rest, both));
+   EXPECT_EQ(DecisionDiagram::EMPTY, diagram.subtract(both, first));
+}
+
+TEST(ProcessTest, RoundSerialization) {
+   RoundResults original(4, 0x5, 3);
+   original.results[0].cost = 2;
+   original.results[0].robustness = 1. / 3.;
+   original.results[0].trans = { { 0, 1 }, { 1, 3 } };
+   original.results[2].block_cost = 3;
+   original.results[2].block_depth = 1;
+
+   RoundNo round;
+   const RoundResults received = ProcessManager::deserialize(ProcessManager::serialize(7, original), round);
+   EXPECT_EQ(7u, round);
+   EXPECT_EQ(4u, received.bound);
+   EXPECT_EQ(0x5u, received.members);
+   ASSERT_EQ(3u, received.results.size());
+   EXPECT_EQ(2u, received.results[0].cost);
+   EXPECT_EQ(1. / 3., received.results[0].robustness);
+   EXPECT_EQ(original.results[0].trans, received.results[0].trans);
+   EXPECT_EQ(INF, received.results[2].cost);
+   EXPECT_EQ(3u, received.results[2].block_cost);
+   EXPECT_EQ(1u, received.results[2].block_depth);
+   EXPECT_THROW(ProcessManager::deserialize("7 4 5 3 2", round), runtime_error);
+}
+
+/// A round computed ahead of its consumption, as by the workers.
+struct AheadRound {
+   ParamNo first;
+   RoundResults round;
+};
+
+/**
+ * Consume the rounds in the given order the way the main loop does with cost minimization, with counting all the rounds are computed again once the bound drops.
+ * @param[out] BFS_bound	the final bound
+ * @return the parametrizations with the lowest Cost, in the order of their numbers
+ */
+vector<MinimalBuffer::MinimalParam> consumeMinimal(vector<AheadRound> & rounds, const CheckCase & check_case, const UserOptions & options, size_t & BFS_bound, size_t & drops) {
+   MinimalBuffer minimal(check_case.bound);
+   BFS_bound = check_case.bound;
+   drops = 0;
+   size_t round_no = 0;
+   while (round_no < rounds.size()) {
+      AheadRound & ahead = rounds[round_no++];
+      bool restart = false;
+      for (const size_t member : cscope(ahead.round.results)) {
+         if (((ahead.round.members >> member) & 1) == 0)
+            continue;
+         RoundResults::Member & result = ahead.round.results[member];
+         if (ahead.round.bound != BFS_bound && result.cost != INF)
+            check_case.manager.resolveMember(result, ahead.first + member, BFS_bound, options, check_case.property);
+         if (result.cost != INF && minimal.add(ahead.first + member, move(result))) {
+            BFS_bound = minimal.getBound();
+            drops++;
+            restart = check_case.property.isCountingUsed();
+            if (restart)
+               break;
+         }
+      }
+
+      if (restart) {
+         minimal = MinimalBuffer(BFS_bound);
+         for (AheadRound & again : rounds)
+            again.round = check_case.manager.checkRound(again.first, again.round.results.size(), again.round.members, BFS_bound, options, check_case.property);
+         round_no = 0;
+      }
+   }
+   minimal.resolve(check_case.manager, options, check_case.property);
+
+   vector<MinimalBuffer::MinimalParam> params = minimal.getParams();
+   sort(params.begin(), params.end(), [](const MinimalBuffer::MinimalParam & a, const MinimalBuffer::MinimalParam & b) {
+      return a.param_no < b.param_no;
+   });
+   for (const MinimalBuffer::MinimalParam & param : params)
+      EXPECT_EQ(BFS_bound, param.bound) << "Parametrization " << param.param_no;
+   return params;
+}
+
+/**
+ * Compare the parametrizations that have remained after the minimization with a run started with the final bound.
+ */
+void compareWithFinalBound(const vector<MinimalBuffer::MinimalParam> & params, const CheckCase & check_case, const UserOptions & options, const size_t final_bound) {
+   SynthesisManager reference(check_case.product);
+   vector<MinimalBuffer::MinimalParam> expected;
+   for (const ParamNo param_no : crange(KineticsTranslators::getSpaceSize(check_case.kinetics))) {
+      RoundResults::Member result;
+      result.cost = reference.check(result.trans, result.robustness, param_no, final_bound, options, check_case.property);
+      if (result.cost != INF)
+         expected.push_back({ param_no, final_bound, move(result) });
+   }
+
+   ASSERT_EQ(expected.size(), params.size());
+   for (const size_t i : cscope(expected)) {
+      EXPECT_EQ(expected[i].param_no, params[i].param_no);
+      EXPECT_EQ(expected[i].result.cost, params[i].result.cost) << "Parametrization " << expected[i].param_no;
+      EXPECT_EQ(expected[i].result.trans, params[i].result.trans) << "Parametrization " << expected[i].param_no;
+      EXPECT_DOUBLE_EQ(expected[i].result.robustness, params[i].result.robustness) << "Parametrization " << expected[i].param_no;
+   }
+}
+
+/**
+ * Compute all the rounds under the bound of the case and order them so that those with the higher costs, INF included, come first and the bound drops while they are consumed.
+ */
+vector<AheadRound> computeAhead(const CheckCase & check_case, const UserOptions & options) {
+   const ParamNo space = KineticsTranslators::getSpaceSize(check_case.kinetics);
+   vector<AheadRound> rounds;
+   for (ParamNo first = 0; first < space; first += options.block_size) {
+      const size_t round_size = min<ParamNo>(options.block_size, space - first);
+      const ParamMask members = (static_cast<ParamMask>(1) << round_size) - 1;
+      rounds.push_back({ first, check_case.manager.checkRound(first, round_size, members, check_case.bound, options, check_case.property) });
+   }
+   auto lowest = [](const AheadRound & ahead) {
+      size_t cost = INF;
+      for (const RoundResults::Member & result : ahead.round.results)
+         cost = min(cost, result.cost);
+      return cost;
+   };
+   // Among the rounds of the same cost, the last ones come first, so that the bound is not always lowered by the first parametrization of the case.
+   sort(rounds.begin(), rounds.end(), [&lowest](const AheadRound & a, const AheadRound & b) {
+      return lowest(a) != lowest(b) ? lowest(a) > lowest(b) : a.first > b.first;
+   });
+   return rounds;
+}
+
+TEST_F(SynthesisTest, ParallelMatchesSequential) {
+   const RoundNo ROUNDS = 64;
+   const ParamNo space = KineticsTranslators::getSpaceSize(kin_com_cyc);
+   UserOptions options;
+   options.compute_wintess = options.compute_robustness = true;
+   auto getMembers = [](const RoundNo) { return static_cast<ParamMask>(1); };
+
+   for (const size_t threads_count : { 2u, 3u }) {
+      // The worker that computes the first round stops at the first round of its next chunk until the others have stolen from it.
+      mutex stats_mutex;
+      map<const SynthesisManager *, RoundNo> last_rounds;
+      const SynthesisManager * first_worker = nullptr;
+      bool stolen = false, waited = false;
+      auto computeRound = [&](SynthesisManager & manager, const RoundNo round_no, const ParamMask members, const size_t bound) {
+         bool wait = false;
+         {
+            lock_guard<mutex> lock(stats_mutex);
+            // Fresh chunks come in the ascending order, a round below the last one must have been stolen.
+            stolen |= last_rounds.count(&manager) > 0 && last_rounds[&manager] > round_no;
+            last_rounds[&manager] = max(last_rounds[&manager], round_no);
+            if (round_no == 1)
+               first_worker = &manager;
+            else if (first_worker == &manager && !waited)
+               wait = waited = true;
+         }
+         for (size_t waiting = 0; wait && waiting < 5000; waiting++) {
+            this_thread::sleep_for(chrono::milliseconds(1));
+            lock_guard<mutex> lock(stats_mutex);
+            wait = !stolen;
+         }
+         this_thread::sleep_for(chrono::milliseconds(1));
+         return manager.checkRound((round_no - 1) % space, 1, members, bound, options, ltl_cyc);
+      };
+
+      ParallelManager parallel(threads_count, pro_com_cyc, ROUNDS, INF, false, getMembers, computeRound);
+      SynthesisManager sequential(pro_com_cyc);
+      for (const RoundNo round_no : crange(static_cast<RoundNo>(1), ROUNDS + 1)) {
+         const RoundResults expected = sequential.checkRound((round_no - 1) % space, 1, 1, INF, options, ltl_cyc);
+         const RoundResults computed = parallel.getRound(round_no);
+         EXPECT_EQ(expected.bound, computed.bound) << "Round " << round_no;
+         EXPECT_EQ(expected.members, computed.members) << "Round " << round_no;
+         ASSERT_EQ(expected.results.size(), computed.results.size()) << "Round " << round_no;
+         EXPECT_EQ(expected.results[0].cost, computed.results[0].cost) << "Round " << round_no;
+         EXPECT_EQ(expected.results[0].trans, computed.results[0].trans) << "Round " << round_no;
+         EXPECT_DOUBLE_EQ(expected.results[0].robustness, computed.results[0].robustness) << "Round " << round_no;
+      }
+      EXPECT_TRUE(stolen) << threads_count << " threads";
+      EXPECT_EQ(parallel.getLoadReport().npos, parallel.getLoadReport().find("steals 0,")) << parallel.getLoadReport();
+   }
+}
+
+TEST_F(SynthesisTest, MinimalMatchesFinalBound) {
+   UserOptions options;
+   options.minimalize_cost = options.compute_wintess = options.compute_robustness = true;
+   size_t all_drops = 0, all_flips = 0;
+   for (const CheckCase & check_case : getCheckCases()) {
+      for (const size_t block_size : { 1u, 3u }) {
+         options.block_size = block_size;
+         vector<AheadRound> rounds = computeAhead(check_case, options);
+         size_t BFS_bound, drops;
+         const vector<MinimalBuffer::MinimalParam> params = consumeMinimal(rounds, check_case, options, BFS_bound, drops);
+         all_drops += drops;
+         compareWithFinalBound(params, check_case, options, BFS_bound);
+
+         // With counting, some of the parametrizations accepted with a Cost within the final bound are rejected under it, as their other final states lie behind it.
+         if (check_case.property.isCountingUsed()) {
+            for (const ParamNo param_no : crange(KineticsTranslators::getSpaceSize(check_case.kinetics))) {
+               vector<StateTransition> witness;
+               double robustness;
+               const size_t cost = check_case.manager.check(witness, robustness, param_no, check_case.bound, options, check_case.property);
+               if (cost <= BFS_bound && check_case.manager.check(witness, robustness, param_no, BFS_bound, options, check_case.property) == INF)
+                  all_flips++;
+            }
+         }
+      }
+   }
+   // The bound has to drop for the results accepted under the older bounds to be tested.
+   EXPECT_LT(0u, all_drops);
+   EXPECT_LT(0u, all_flips);
+}
+
+TEST_F(SynthesisTest, SharedBoundMatchesFinalBound) {
+   UserOptions options;
+   options.minimalize_cost = options.compute_wintess = options.compute_robustness = true;
+   size_t all_drops = 0;
+   for (const CheckCase & check_case : getCheckCases()) {
+      if (!SynthesisManager::isBoundShareable(options, check_case.property))
+         continue;
+      // The rounds are ordered by the costs found without the shared bound.
+      vector<AheadRound> rounds = computeAhead(check_case, options);
+      atomic<size_t> shared_bound(check_case.bound);
+      SynthesisManager shared(check_case.product);
+      shared.shareBound(&shared_bound);
+      size_t lowest = INF;
+      for (AheadRound & ahead : rounds) {
+         const size_t round_size = ahead.round.results.size();
+         ahead.round = shared.checkRound(ahead.first, round_size, ahead.round.members, check_case.bound, options, check_case.property);
+         for (const RoundResults::Member & result : ahead.round.results) {
+            // The costs above the shared bound are not found.
+            if (result.cost != INF)
+               EXPECT_GE(ahead.round.bound, result.cost);
+            lowest = min(lowest, result.cost);
+         }
+         EXPECT_EQ(min(check_case.bound, lowest), shared_bound.load());
+      }
+
+      size_t BFS_bound, drops;
+      const vector<MinimalBuffer::MinimalParam> params = consumeMinimal(rounds, check_case, options, BFS_bound, drops);
+      all_drops += drops;
+      compareWithFinalBound(params, check_case, options, BFS_bound);
+      if (!params.empty())
+         EXPECT_EQ(params.front().result.cost, shared_bound.load());
+   }
+   EXPECT_LT(0u, all_drops);
+}
+
+TEST_F(SynthesisTest, PlanSmallShare) {
+   UserOptions options;
+   ParallelPlanner planner(pro_cir_one, ltl_one, options);
+   // A process of --dist i N may get no parametrizations when there are fewer than N.
+   const ParallelPlan empty = planner.plan(0);
+   EXPECT_EQ(1u, empty.threads_count);
+   EXPECT_EQ(1u, empty.bfs_threads_count);
+   EXPECT_EQ(1u, empty.block_size);
+   // All the parametrizations are checked by the calibration.
+   const ParallelPlan single = planner.plan(KineticsTranslators::getSpaceSize(kin_cir_one));
+   EXPECT_EQ(1u, single.threads_count);
+   EXPECT_EQ(1u, single.bfs_threads_count);
+}
+
 TEST_F(SynthesisTest, AnalysisOnTrivial) {
    vector<StateTransition> witness; double robust;
    for (ParamNo param_no = 0; param_no < KineticsTranslators::getSpaceSize(kin_com_tri); param_no++) {
@@ -115,6 +509,32 @@ TEST_F(SynthesisTest, CycleOnCircuitAnalysis) {
    EXPECT_DOUBLE_EQ(0.25, robutness_val);
 }
 
+TEST_F(SynthesisTest, SharedLevelsMatchSingle) {
+   // With ranges of a single item, each level is split between the threads.
+   ColorStorage storage(pro_cir_cyc), shared_storage(pro_cir_cyc);
+   ModelChecker checker(pro_cir_cyc, storage), shared_checker(pro_cir_cyc, shared_storage);
+   shared_checker.setThreads(3, 1);
+
+   auto compare = [&](const CheckerSettings & settings) {
+      const SynthesisResults results = checker.conductCheck(settings);
+      const SynthesisResults shared = shared_checker.conductCheck(settings);
+      EXPECT_EQ(results.found_depth, shared.found_depth);
+      for (const StateID ID : crange(pro_cir_cyc.getStateCount()))
+         EXPECT_EQ(storage.getColor(ID), shared_storage.getColor(ID));
+   };
+
+   CheckerSettings settings;
+   settings.mark_initals = true;
+   compare(settings);
+   settings.minimize_cost = true;
+   compare(settings);
+   settings.mark_initals = false;
+   for (const StateID ID : crange(pro_cir_cyc.getStateCount())) {
+      settings.initial_states = settings.final_states = {ID};
+      compare(settings);
+   }
+}
+
 TEST_F(SynthesisTest, TestPeakOnCircuit) {
    // Change to the K_2
    vector<StateTransition> witness; double robust;
@@ -202,6 +622,158 @@ TEST_F(SynthesisTest, TestExperiment) {
 	}
 }
 
+TEST_F(SynthesisTest, BlockMatchesSingle) {
+   const size_t BLOCK = 3;
+   compareWithSingle(getCheckCases(), false, [BLOCK](const CheckCase & check_case, const UserOptions &) {
+      const ParamNo space = KineticsTranslators::getSpaceSize(check_case.kinetics);
+      vector<CheckOutcome> outcomes;
+      for (ParamNo first = 0; first < space; first += BLOCK) {
+         ParamMask members = 0;
+         for (const size_t member : crange(BLOCK))
+            if (first + member < space)
+               members |= static_cast<ParamMask>(1) << member;
+         vector<size_t> depths;
+         const vector<size_t> costs = check_case.product.getMyType() == BA_finite
+            ? check_case.manager.checkFiniteBlock(depths, first, members, check_case.bound, check_case.property.getMinAcc(), check_case.property.getMaxAcc())
+            : check_case.manager.checkFullBlock(depths, first, members, check_case.bound);
+
+         for (const size_t member : crange(BLOCK)) {
+            if (((members >> member) & 1) == 0)
+               continue;
+            if (costs[member] != INF)
+               EXPECT_GE(check_case.bound, depths[member]);
+            outcomes.push_back({ costs[member], {}, 0. });
+         }
+      }
+      return outcomes;
+   });
+}
 
+TEST_F(SynthesisTest, SymbolicMatchesSingle) {
+   // The counting of the accepting states is not supported by the symbolic checker.
+   vector<CheckCase> cases;
+   for (const CheckCase & check_case : getCheckCases())
+      if (check_case.property.getMinAcc() == 1)
+         cases.push_back(check_case);
+
+   compareWithSingle(cases, false, [](const CheckCase & check_case, const UserOptions &) {
+      SymbolicChecker checker(check_case.product, check_case.kinetics);
+      const vector<DecisionDiagram::Node> costs = checker.computeCosts(check_case.bound);
+      vector<CheckOutcome> outcomes;
+      for (const ParamNo param_no : crange(KineticsTranslators::getSpaceSize(check_case.kinetics))) {
+         size_t symbolic = INF;
+         for (const size_t cost : cscope(costs))
+            if (checker.getDiagram().contains(costs[cost], param_no))
+               symbolic = cost;
+         outcomes.push_back({ symbolic, {}, 0. });
+      }
+      return outcomes;
+   });
+}
+
+TEST_F(SynthesisTest, IntervalMatchesSingle) {
+   const ParamNo WINDOW = 5;
+   compareWithSingle(getCheckCases(), false, [WINDOW](const CheckCase & check_case, const UserOptions &) {
+      const ParamNo space = KineticsTranslators::getSpaceSize(check_case.kinetics);
+      vector<CheckOutcome> outcomes;
+      for (ParamNo first = 0; first < space; first += WINDOW) {
+         const ParamNo end = min(first + WINDOW, space);
+         vector<size_t> depths;
+         const vector<size_t> costs = check_case.product.getMyType() == BA_finite
+            ? check_case.manager.checkFiniteInterval(depths, first, end, check_case.bound, check_case.property.getMinAcc(), check_case.property.getMaxAcc())
+            : check_case.manager.checkFullInterval(depths, first, end, check_case.bound);
+
+         for (const ParamNo param_no : crange(first, end)) {
+            if (costs[param_no - first] != INF)
+               EXPECT_GE(check_case.bound, depths[param_no - first]);
+            outcomes.push_back({ costs[param_no - first], {}, 0. });
+         }
+      }
+      return outcomes;
+   });
+}
+
+TEST_F(SynthesisTest, IncrementalMatchesSingle) {
+   compareWithSingle(getCheckCases(), true, [](const CheckCase & check_case, const UserOptions & options) {
+      SynthesisManager incremental(check_case.product);
+      incremental.setIncremental(true);
+      // Forth and back, so that the checks are resumed after changes in both directions.
+      const ParamNo space = KineticsTranslators::getSpaceSize(check_case.kinetics);
+      vector<CheckOutcome> outcomes(2 * space);
+      for (const ParamNo step : crange(2 * space)) {
+         const ParamNo param_no = step < space ? step : 2 * space - step - 1;
+         CheckOutcome & outcome = outcomes[step < space ? param_no : space + param_no];
+         outcome.robustness = 0.;
+         outcome.cost = incremental.check(outcome.witness, outcome.robustness, param_no, check_case.bound, options, check_case.property);
+      }
+      return outcomes;
+   });
+}
+
+TEST_F(SynthesisTest, MemoizedMatchesSingle) {
+   size_t all_hits = 0;
+   compareWithSingle(getCheckCases(), false, [&all_hits](const CheckCase & check_case, const UserOptions & options) {
+      SynthesisManager memoized(check_case.product);
+      UserOptions memo = options;
+      memo.use_memoization = true;
+      vector<CheckOutcome> outcomes;
+      const ParamNo space = KineticsTranslators::getSpaceSize(check_case.kinetics);
+      for (const ParamNo param_no : crange(space)) {
+         vector<StateTransition> witness; double robust = 0.;
+         outcomes.push_back({ memoized.check(witness, robust, param_no, check_case.bound, memo, check_case.property), {}, 0. });
+      }
+      // Each parametrization is looked up once, the first one can not be found.
+      EXPECT_EQ(space, memoized.getCache().getLookupCount());
+      EXPECT_GT(space, memoized.getCache().getHitCount());
+      all_hits += memoized.getCache().getHitCount();
+      return outcomes;
+   });
+   EXPECT_LT(0u, all_hits);
+
+   const string report = ResultCache::getHitReport(11, 20);
+   EXPECT_NE(report.npos, report.find("11 of 20 parametrizations (55.0")) << report;
+}
+
+TEST_F(SynthesisTest, PrunedMatchesFull) {
+   compareWithSingle(getCheckCases(), true, [](const CheckCase & check_case, const UserOptions & options) {
+      ProductStructure pruned = ConstructionManager::construct(check_case.model, check_case.property, check_case.kinetics);
+      ConstructionManager::prune(pruned);
+      EXPECT_GE(check_case.product.getStateCount(), pruned.getStateCount());
+      for (const StateID ID : crange(pruned.getStateCount()))
+         EXPECT_EQ(ID, pruned.getProductID(pruned.getKSID(ID), pruned.getBAID(ID)));
+
+      // The witnesses are compared in the IDs of the full product.
+      SynthesisManager pruned_manager(pruned);
+      vector<CheckOutcome> outcomes;
+      for (const ParamNo param_no : crange(KineticsTranslators::getSpaceSize(check_case.kinetics))) {
+         CheckOutcome outcome = { INF, {}, 0. };
+         outcome.cost = pruned_manager.check(outcome.witness, outcome.robustness, param_no, check_case.bound, options, check_case.property);
+         for (StateTransition & trans : outcome.witness)
+            trans = StateTransition(pruned.getOriginalID(trans.first), pruned.getOriginalID(trans.second));
+         outcomes.push_back(move(outcome));
+      }
+      return outcomes;
+   });
+}
+
+TEST_F(SynthesisTest, GuidedMatchesSingle) {
+   // The guidance is used for the finite automata only.
+   vector<CheckCase> cases = { { sym_cir_one, pro_cir_one, mod_cir, ltl_one, kin_cir_one, 1 } };
+   for (const CheckCase & check_case : getCheckCases())
+      if (check_case.product.getMyType() == BA_finite)
+         cases.push_back(check_case);
+
+   compareWithSingle(cases, true, [](const CheckCase & check_case, const UserOptions & options) {
+      SynthesisManager guided(check_case.product);
+      guided.setBackwardGuidance(true);
+      vector<CheckOutcome> outcomes;
+      for (const ParamNo param_no : crange(KineticsTranslators::getSpaceSize(check_case.kinetics))) {
+         CheckOutcome outcome = { INF, {}, 0. };
+         outcome.cost = guided.check(outcome.witness, outcome.robustness, param_no, check_case.bound, options, check_case.property);
+         outcomes.push_back(move(outcome));
+      }
+      return outcomes;
+   });
+}
 
 #endif // SYNTHESIS_TESTS_HPP
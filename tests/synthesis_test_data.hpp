@@ -10,8 +10,22 @@
 #define SYNTHESIS_TEST_DATA_HPP
 
 #include "../synthesis/synthesis_manager.hpp"
+#include "../synthesis/minimal_buffer.hpp"
+#include "../synthesis/process_manager.hpp"
+#include "../synthesis/parallel_planner.hpp"
+#include "../synthesis/symbolic_checker.hpp"
 #include "construction_test_data.hpp"
 
+/// A product whose parametrizations are all checked under the bound, the reference results are obtained by the manager.
+struct CheckCase {
+	SynthesisManager & manager;
+	const ProductStructure & product;
+	const Model & model;
+	const PropertyAutomaton & property;
+	const Kinetics & kinetics;
+	size_t bound;
+};
+
 class SynthesisTest : public StructureTest {
 protected:
 	SynthesisManager sym_cir_one;
@@ -21,6 +35,7 @@ protected:
 	SynthesisManager sym_com_cyc;
 	SynthesisManager sym_com_sta;
 	SynthesisManager sym_com_top;
+	SynthesisManager sym_com_two;
 	SynthesisManager sym_com_tri;
 	SynthesisManager sym_mul_cyc;
 	SynthesisManager sym_mul_mul;
@@ -37,10 +52,27 @@ protected:
 		sym_cir_one = SynthesisManager(pro_cir_one);
 		sym_cir_cyc = SynthesisManager(pro_cir_cyc);
 		sym_com_top = SynthesisManager(pro_com_top);
+		sym_com_two = SynthesisManager(pro_com_two);
 		sym_com_sta = SynthesisManager(pro_com_sta);
 		sym_com_bst = SynthesisManager(pro_com_bst);
 		sym_cir_exp = SynthesisManager(pro_cir_exp);
 	}
+
+	/* The products of both the finite and the standard automata, with and without a bound. */
+	vector<CheckCase> getCheckCases() {
+		return {
+			{ sym_com_tri, pro_com_tri, mod_com, ltl_tri, kin_com_tri, INF },
+			{ sym_com_bst, pro_com_bst, mod_com, ltl_bst, kin_com_bst, INF },
+			{ sym_cir_one, pro_cir_one, mod_cir, ltl_one, kin_cir_one, 3 },
+			{ sym_cir_exp, pro_cir_exp, mod_cir, ltl_exp, kin_cir_exp, INF },
+			{ sym_mul_mul, pro_mul_mul, mod_mul, ltl_mul, kin_mul_mul, INF },
+			{ sym_com_cyc, pro_com_cyc, mod_com, ltl_cyc, kin_com_cyc, INF },
+			{ sym_com_cyc, pro_com_cyc, mod_com, ltl_cyc, kin_com_cyc, 3 },
+			{ sym_com_top, pro_com_top, mod_com, ltl_top, kin_com_top, INF },
+			{ sym_com_two, pro_com_two, mod_com, ltl_two, kin_com_two, INF },
+			{ sym_cir_cyc, pro_cir_cyc, mod_cir, ltl_cyc, kin_cir_cyc, INF }
+		};
+	}
 };
 
 #endif // SYNTHESIS_TEST_DATA_HPP